@@ -0,0 +1,181 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: biquad_benchmark.cpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+// Compares the per-sample path of the Biquad filters (tick) with the block kernels of biquad, multichannel_biquad and
+// multichannel_biquad_cascade, the serial and parallel realizations of a high order design, and the cost of sweeping
+// the cutoff of a resonant low-pass filter at control rate.
+// Usage: biquad_benchmark [samples] [repetitions]
+
+#include <edsp/filter/biquad.hpp>
+#include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/filter/internal/butterworth_designer.hpp>
+#include <edsp/filter/internal/rbj_designer.hpp>
+#include <edsp/filter/multichannel_biquad.hpp>
+#include <edsp/filter/modulated_biquad.hpp>
+#include <edsp/filter/multichannel_biquad_cascade.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+
+    using value_type = float;
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr std::size_t channels = 8;
+    constexpr std::size_t stages   = 4;
+    constexpr std::size_t control  = 32;
+
+    template <typename Function>
+    double best_of(std::size_t repetitions, Function&& function) {
+        auto best = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < repetitions; ++i) {
+            const auto start = clock_type::now();
+            function();
+            const auto elapsed = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+            best               = std::min(best, elapsed);
+        }
+        return best;
+    }
+
+    edsp::filter::biquad<value_type> make_section(std::size_t index) {
+        // Stable resonant sections with slightly different poles.
+        const auto radius = static_cast<value_type>(0.9 + 0.01 * static_cast<double>(index % 8));
+        const auto angle  = static_cast<value_type>(0.1 + 0.05 * static_cast<double>(index));
+        return edsp::filter::biquad<value_type>(1, -2 * radius * std::cos(angle), radius * radius, 1, 2, 1);
+    }
+
+    void report(const char* name, double reference, double elapsed, std::size_t samples) {
+        std::printf("%-40s %10.3f ms %10.1f Msamples/s %8.2fx\n", name, elapsed,
+                    static_cast<double>(samples) / (elapsed * 1e3), reference / elapsed);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const auto samples     = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : (1ul << 20);
+    const auto repetitions = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 10ul;
+
+    std::vector<value_type> input(samples * channels);
+    std::vector<value_type> output(samples * channels);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<value_type>(std::sin(0.01 * static_cast<double>(i)));
+    }
+
+    std::printf("%lu samples per channel, best of %lu runs\n", samples, repetitions);
+
+    // Single section.
+    auto section = make_section(0);
+    const auto section_tick = best_of(repetitions, [&]() {
+        for (std::size_t i = 0; i < samples; ++i) {
+            output[i] = section.tick(input[i]);
+        }
+    });
+    const auto section_block =
+        best_of(repetitions, [&]() { section.filter(input.data(), input.data() + samples, output.data()); });
+    report("biquad, tick", section_tick, section_tick, samples);
+    report("biquad, filter", section_tick, section_block, samples);
+
+    // Independent channels of an interleaved signal.
+    std::array<edsp::filter::biquad<value_type>, channels> bank;
+    edsp::filter::multichannel_biquad<value_type, channels> lanes;
+    for (std::size_t c = 0; c < channels; ++c) {
+        bank[c] = make_section(c);
+        lanes.set(c, bank[c]);
+    }
+    const auto bank_channels = best_of(repetitions, [&]() {
+        for (std::size_t c = 0; c < channels; ++c) {
+            for (std::size_t i = 0; i < samples; ++i) {
+                output[i * channels + c] = bank[c].tick(input[i * channels + c]);
+            }
+        }
+    });
+    const auto bank_frames = best_of(repetitions, [&]() {
+        for (std::size_t i = 0; i < samples; ++i) {
+            for (std::size_t c = 0; c < channels; ++c) {
+                output[i * channels + c] = bank[c].tick(input[i * channels + c]);
+            }
+        }
+    });
+    const auto lanes_block = best_of(repetitions, [&]() {
+        lanes.filter(input.data(), input.data() + samples * channels, output.data());
+    });
+    report("8 x biquad, tick, channel by channel", bank_channels, bank_channels, samples * channels);
+    report("8 x biquad, tick, frame by frame", bank_channels, bank_frames, samples * channels);
+    report("multichannel_biquad<8>, filter", bank_channels, lanes_block, samples * channels);
+
+    // The same cascade applied to every channel of an interleaved signal.
+    std::array<edsp::filter::biquad_cascade<value_type, stages>, channels> cascades;
+    edsp::filter::multichannel_biquad_cascade<value_type, stages, channels> shared;
+    for (std::size_t s = 0; s < stages; ++s) {
+        for (auto& cascade : cascades) {
+            cascade.push_back(make_section(s));
+        }
+        shared.push_back(make_section(s));
+    }
+    const auto cascades_channels = best_of(repetitions, [&]() {
+        for (std::size_t c = 0; c < channels; ++c) {
+            for (std::size_t i = 0; i < samples; ++i) {
+                output[i * channels + c] = cascades[c].tick(input[i * channels + c]);
+            }
+        }
+    });
+    const auto shared_block = best_of(repetitions, [&]() {
+        shared.filter(input.data(), input.data() + samples * channels, output.data());
+    });
+    report("8 x biquad_cascade<4>, tick", cascades_channels, cascades_channels, samples * channels);
+    report("multichannel_biquad_cascade<4, 8>, filter", cascades_channels, shared_block, samples * channels);
+
+    // Serial and parallel realizations of a 16th order Butterworth low-pass filter.
+    edsp::filter::butterworth::LowPass<value_type, 16> designer;
+    auto serial   = designer.design(16ul, static_cast<value_type>(44100), static_cast<value_type>(1000));
+    auto parallel = designer.design_parallel(16ul, static_cast<value_type>(44100), static_cast<value_type>(1000));
+    const auto serial_block =
+        best_of(repetitions, [&]() { serial.filter(input.data(), input.data() + samples, output.data()); });
+    const auto parallel_block =
+        best_of(repetitions, [&]() { parallel.filter(input.data(), input.data() + samples, output.data()); });
+    report("butterworth<16>, biquad_cascade", serial_block, serial_block, samples);
+    report("butterworth<16>, biquad_parallel", serial_block, parallel_block, samples);
+
+    // Resonant low-pass filter whose cutoff moves every control block.
+    const auto sample_rate = static_cast<value_type>(44100);
+    const auto quality     = static_cast<value_type>(4);
+    std::vector<value_type> cutoff(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        cutoff[i] = static_cast<value_type>(1000 + 800 * std::sin(1e-4 * static_cast<double>(i)));
+    }
+    edsp::filter::RBJFilterDesigner<value_type, edsp::filter::filter_type::LowPass> rbj;
+    edsp::filter::modulated_biquad<value_type> modulated;
+    const auto sweep_block = best_of(repetitions, [&]() {
+        for (std::size_t i = 0; i < samples; i += control) {
+            modulated.ramp(rbj(cutoff[i], sample_rate, quality), control);
+            modulated.filter(input.data() + i, input.data() + std::min(i + control, samples), output.data() + i);
+        }
+    });
+    report("modulated_biquad, ramp every 32 samples", section_block, sweep_block, samples);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: fft_threads_benchmark.cpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+// Measures how the Real-to-Complex and Complex-to-Complex transforms of very large sizes scale with the number of
+// threads of the fft_engine. Usage: fft_threads_benchmark [log2(size)] [repetitions]
+
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using value_type   = double;
+    using complex_type = std::complex<value_type>;
+    using clock_type   = std::chrono::steady_clock;
+
+    template <typename Function>
+    double best_of(std::size_t repetitions, Function&& function) {
+        auto best = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < repetitions; ++i) {
+            const auto start = clock_type::now();
+            function();
+            const auto elapsed = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+            best               = std::min(best, elapsed);
+        }
+        return best;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const auto exponent    = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 24ul;
+    const auto repetitions = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 5ul;
+    const auto size        = std::size_t{1} << exponent;
+    const auto cores       = std::max(1u, std::thread::hardware_concurrency());
+
+    edsp::aligned_buffer<value_type> real(size);
+    edsp::aligned_buffer<complex_type> complex(size);
+    edsp::aligned_buffer<complex_type> spectrum(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        real[i]    = std::sin(0.001 * static_cast<value_type>(i)) + std::cos(0.37 * static_cast<value_type>(i));
+        complex[i] = complex_type(real[i], -real[i]);
+    }
+
+    std::printf("size: 2^%lu samples, best of %lu runs\n", exponent, repetitions);
+    std::printf("%8s %14s %10s %14s %10s\n", "threads", "r2c (ms)", "speedup", "c2c (ms)", "speedup");
+
+    double r2c_reference = 0;
+    double c2c_reference = 0;
+    for (std::size_t threads = 1; threads <= cores; threads *= 2) {
+        edsp::fft_engine<value_type> engine(size, edsp::planning_rigor::Estimate, threads);
+        if (engine.threads() != threads) {
+            std::printf("%8zu %14s\n", threads, "unsupported: build with USE_LIBFFTW_THREADS");
+            break;
+        }
+
+        const auto r2c = best_of(repetitions, [&]() { engine.dft(real.data(), spectrum.data()); });
+        const auto c2c = best_of(repetitions, [&]() { engine.dft(complex.data(), spectrum.data()); });
+        if (threads == 1) {
+            r2c_reference = r2c;
+            c2c_reference = c2c;
+        }
+        std::printf("%8zu %14.3f %10.2f %14.3f %10.2f\n", threads, r2c, r2c_reference / r2c, c2c,
+                    c2c_reference / c2c);
+    }
+    return 0;
+}
@@ -23,5 +23,6 @@
 void add_feature_temporal_package();
 void add_feature_spectral_package();
 void add_feature_statistics_package();
+void add_feature_perceptual_package();
 
 #endif /* EDSP_PYTHON_BINDINGS_FEATURE_HPP */
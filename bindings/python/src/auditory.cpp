@@ -21,6 +21,7 @@
 #include "boost_numpy_dependencies.hpp"
 #include <cedsp/types.h>
 #include <edsp/auditory/audspace.hpp>
+#include <edsp/auditory/filterbank.hpp>
 #include <edsp/auditory/converter/mel2hertz.hpp>
 #include <edsp/auditory/converter/erb2hertz.hpp>
 #include <edsp/auditory/converter/cent2hertz.hpp>
@@ -93,6 +94,36 @@ bn::ndarray melspace(real_t min, real_t max, long size) noexcept {
     return generate_python(edsp::auditory::melspace<real_t*, real_t>, min, max, size);
 }
 
+using filterbank = edsp::auditory::filterbank<real_t>;
+
+bn::ndarray filterbank_frequencies_python(const filterbank& bank) {
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(bank.size())};
+    auto result          = bn::empty(1, shape, bn::dtype::get_builtin<real_t>());
+    bank.frequencies(reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+bn::ndarray filterbank_weights_python(const filterbank& bank) {
+    Py_intptr_t shape[2] = {static_cast<Py_intptr_t>(bank.size()), static_cast<Py_intptr_t>(bank.bins())};
+    auto result          = bn::empty(2, shape, bn::dtype::get_builtin<real_t>());
+    bank.weights(reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+bn::ndarray filterbank_apply_python(const filterbank& bank, bn::ndarray& power) {
+    if (power.get_nd() != 1) {
+        throw std::invalid_argument("Expected one-dimensional arrays");
+    }
+    if (static_cast<std::size_t>(power.shape(0)) != bank.bins()) {
+        throw std::invalid_argument("Expected a power spectrum of bins() elements");
+    }
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(bank.size())};
+    auto result          = bn::empty(1, shape, bn::dtype::get_builtin<real_t>());
+    auto* data           = reinterpret_cast<const real_t*>(power.get_data());
+    bank.apply(data, data + bank.bins(), reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
 void add_auditory_package() {
     std::string nested_name = bp::extract<std::string>(bp::scope().attr("__name__") + ".auditory");
     bp::object nested_module(bp::handle<>(bp::borrowed(PyImport_AddModule(nested_name.c_str()))));
@@ -111,4 +142,24 @@ void add_auditory_package() {
     bp::def("barkspace", barkspace);
     bp::def("centspace", centspace);
     bp::def("melspace", melspace);
+
+    bp::enum_<edsp::auditory::auditory_scale>("AuditoryScale")
+        .value("Mel", edsp::auditory::auditory_scale::mel)
+        .value("Erb", edsp::auditory::auditory_scale::erb)
+        .value("Bark", edsp::auditory::auditory_scale::bark)
+        .value("Cent", edsp::auditory::auditory_scale::cent);
+
+    bp::enum_<edsp::auditory::filterbank_shape>("FilterbankShape")
+        .value("Triangular", edsp::auditory::filterbank_shape::Triangular)
+        .value("Gammatone", edsp::auditory::filterbank_shape::Gammatone);
+
+    bp::class_<filterbank>("Filterbank", bp::init<std::size_t, std::size_t, real_t, real_t, real_t,
+                                                  bp::optional<edsp::auditory::auditory_scale,
+                                                               edsp::auditory::filterbank_shape, bool>>())
+        .def("size", &filterbank::size)
+        .def("bins", &filterbank::bins)
+        .def("nonzeros", &filterbank::nonzeros)
+        .def("frequencies", filterbank_frequencies_python)
+        .def("weights", filterbank_weights_python)
+        .def("apply", filterbank_apply_python);
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) 2019 mboujemaoui
+ * 
+ * This file is part of eDSP.
+ * 
+ * eDSP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * eDSP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with eDSP.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "feature.hpp"
+#include "boost_numpy_dependencies.hpp"
+
+#include <cedsp/types.h>
+#include <edsp/feature/perceptual/mfcc.hpp>
+
+using mfcc = edsp::feature::perceptual::mfcc<real_t>;
+
+bn::ndarray mfcc_process_python(mfcc& extractor, bn::ndarray& input) {
+    if (input.get_nd() != 1) {
+        throw std::invalid_argument("Expected one-dimensional arrays");
+    }
+    const auto size      = input.shape(0);
+    const auto frames    = extractor.frames(static_cast<std::size_t>(size));
+    Py_intptr_t shape[2] = {static_cast<Py_intptr_t>(frames), static_cast<Py_intptr_t>(extractor.features())};
+    auto result          = bn::zeros(2, shape, bn::dtype::get_builtin<real_t>());
+    auto* data           = reinterpret_cast<real_t*>(input.get_data());
+    extractor.process(data, data + size, reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+bn::ndarray mfcc_flush_python(mfcc& extractor) {
+    Py_intptr_t shape[2] = {static_cast<Py_intptr_t>(extractor.pending()),
+                            static_cast<Py_intptr_t>(extractor.features())};
+    auto result          = bn::zeros(2, shape, bn::dtype::get_builtin<real_t>());
+    extractor.flush(reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+void add_feature_perceptual_package() {
+    std::string nested_name = bp::extract<std::string>(bp::scope().attr("__name__") + ".perceptual");
+    bp::object nested_module(bp::handle<>(bp::borrowed(PyImport_AddModule(nested_name.c_str()))));
+    bp::scope().attr("perceptual") = nested_module;
+    bp::scope parent               = nested_module;
+
+    bp::class_<mfcc, boost::noncopyable>(
+        "Mfcc", bp::init<real_t, std::size_t, std::size_t,
+                         bp::optional<std::size_t, std::size_t, real_t, real_t, real_t, std::size_t, std::size_t>>())
+        .def("frame_size", &mfcc::frame_size)
+        .def("hop_size", &mfcc::hop_size)
+        .def("coefficients", &mfcc::coefficients)
+        .def("features", &mfcc::features)
+        .def("latency", &mfcc::latency)
+        .def("frames", &mfcc::frames)
+        .def("pending", &mfcc::pending)
+        .def("reset", &mfcc::reset)
+        .def("process", mfcc_process_python)
+        .def("flush", mfcc_flush_python);
+}
@@ -34,6 +34,8 @@
 #include <edsp/feature/spectral/spectral_slope.hpp>
 #include <edsp/feature/spectral/spectral_spread.hpp>
 #include <edsp/feature/spectral/spectral_variation.hpp>
+#include <edsp/spectral/split_complex.hpp>
+#include <complex>
 
 template <class Functor, typename... Args>
 auto execute(Functor&& f, bn::ndarray& input, Args... arg) {
@@ -121,6 +123,108 @@ auto spectral_slope_python(bn::ndarray& first, bn::ndarray& second) {
     return execute<callback>(edsp::feature::spectral::spectral_slope<real_t*>, first, second);
 }
 
+// Copies a complex spectrum into a split_complex_buffer, the layout produced by the split-complex transforms.
+edsp::split_complex_buffer<real_t> make_split(const bn::ndarray& input) {
+    if (input.get_nd() != 1) {
+        throw std::invalid_argument("Expected one-dimensional arrays");
+    }
+    if (input.get_dtype() != bn::dtype::get_builtin<std::complex<real_t>>()) {
+        throw std::invalid_argument("Expected complex arrays");
+    }
+    const auto size  = static_cast<std::size_t>(input.shape(0));
+    const auto* data = reinterpret_cast<const std::complex<real_t>*>(input.get_data());
+    edsp::split_complex_buffer<real_t> buffer(size);
+    const auto view = buffer.view();
+    for (std::size_t i = 0; i < size; ++i) {
+        view.real()[i] = data[i].real();
+        view.imag()[i] = data[i].imag();
+    }
+    return buffer;
+}
+
+const real_t* split_weights(const bn::ndarray& weights, std::size_t size) {
+    if (weights.get_nd() != 1 || static_cast<std::size_t>(weights.shape(0)) < size) {
+        throw std::invalid_argument("Expected one-dimensional arrays with a weight per bin");
+    }
+    return reinterpret_cast<const real_t*>(weights.get_data());
+}
+
+void check_split_sizes(const edsp::split_complex_buffer<real_t>& first,
+                       const edsp::split_complex_buffer<real_t>& second) {
+    if (first.size() != second.size()) {
+        throw std::invalid_argument("Expected spectra of the same size");
+    }
+}
+
+auto split_spectral_crest_python(const bn::ndarray& spectrum) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_crest(split.view());
+}
+
+auto split_spectral_kurtosis_python(const bn::ndarray& spectrum) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_kurtosis(split.view());
+}
+
+auto split_spectral_skewness_python(const bn::ndarray& spectrum) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_skewness(split.view());
+}
+
+auto split_spectral_entropy_python(const bn::ndarray& spectrum) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_entropy(split.view());
+}
+
+auto split_spectral_rolloff_python(const bn::ndarray& spectrum, real_t percentage) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_rolloff(split.view(), percentage);
+}
+
+auto split_spectral_flatness_python(const bn::ndarray& spectrum) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_flatness(split.view());
+}
+
+auto split_spectral_irregularity_python(const bn::ndarray& spectrum) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_irregularity(split.view());
+}
+
+auto split_spectral_decrease_python(const bn::ndarray& spectrum) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_decrease(split.view());
+}
+
+auto split_spectral_centroid_python(const bn::ndarray& spectrum, const bn::ndarray& weights) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_centroid(split.view(), split_weights(weights, split.size()));
+}
+
+auto split_spectral_spread_python(const bn::ndarray& spectrum, const bn::ndarray& weights) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_spread(split.view(), split_weights(weights, split.size()));
+}
+
+auto split_spectral_slope_python(const bn::ndarray& spectrum, const bn::ndarray& weights) {
+    const auto split = make_split(spectrum);
+    return edsp::feature::spectral::spectral_slope(split.view(), split_weights(weights, split.size()));
+}
+
+auto split_spectral_variation_python(const bn::ndarray& first, const bn::ndarray& second) {
+    const auto current  = make_split(first);
+    const auto previous = make_split(second);
+    check_split_sizes(current, previous);
+    return edsp::feature::spectral::spectral_variation(current.view(), previous.view());
+}
+
+auto split_spectral_flux_python(const bn::ndarray& first, const bn::ndarray& second) {
+    const auto current  = make_split(first);
+    const auto previous = make_split(second);
+    check_split_sizes(current, previous);
+    return edsp::feature::spectral::spectral_flux(current.view(), previous.view());
+}
+
 void add_feature_spectral_package() {
     std::string nested_name = bp::extract<std::string>(bp::scope().attr("__name__") + ".spectral");
     bp::object nested_module(bp::handle<>(bp::borrowed(PyImport_AddModule(nested_name.c_str()))));
@@ -140,4 +244,17 @@ void add_feature_spectral_package() {
     bp::def("spectral_slope", spectral_slope_python);
     bp::def("spectral_spread", spectral_spread_python);
     bp::def("spectral_variation", spectral_variation_python);
+    bp::def("split_spectral_centroid", split_spectral_centroid_python);
+    bp::def("split_spectral_crest", split_spectral_crest_python);
+    bp::def("split_spectral_decrease", split_spectral_decrease_python);
+    bp::def("split_spectral_entropy", split_spectral_entropy_python);
+    bp::def("split_spectral_flatness", split_spectral_flatness_python);
+    bp::def("split_spectral_flux", split_spectral_flux_python);
+    bp::def("split_spectral_irregularity", split_spectral_irregularity_python);
+    bp::def("split_spectral_kurtosis", split_spectral_kurtosis_python);
+    bp::def("split_spectral_rolloff", split_spectral_rolloff_python);
+    bp::def("split_spectral_skewness", split_spectral_skewness_python);
+    bp::def("split_spectral_slope", split_spectral_slope_python);
+    bp::def("split_spectral_spread", split_spectral_spread_python);
+    bp::def("split_spectral_variation", split_spectral_variation_python);
 }
\ No newline at end of file
@@ -21,6 +21,10 @@
 #include "boost_numpy_dependencies.hpp"
 #include <cedsp/types.h>
 #include <edsp/filter.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 template <typename Class>
 auto wrapper_filter(Class& obj, bn::ndarray& input) {
@@ -40,6 +44,24 @@ auto wrapper_median_filter(edsp::filter::moving_median<real_t>& obj, bn::ndarray
     return wrapper_filter(obj, input);
 }
 
+auto wrapper_quantile_filter(edsp::filter::moving_quantile<real_t>& obj, bn::ndarray& input) {
+    return wrapper_filter(obj, input);
+}
+
+auto wrapper_integral_quantile_filter(edsp::filter::moving_quantile<std::int64_t>& obj, bn::ndarray& input) {
+    if (input.get_nd() != 1) {
+        throw std::invalid_argument("Expected one-dimensional arrays");
+    }
+    const auto size      = input.shape(0);
+    Py_intptr_t shape[1] = {size};
+    auto values          = input.astype(bn::dtype::get_builtin<std::int64_t>());
+    auto result          = bn::empty(1, shape, bn::dtype::get_builtin<std::int64_t>());
+    auto data            = reinterpret_cast<std::int64_t*>(values.get_data());
+    auto output          = reinterpret_cast<std::int64_t*>(result.get_data());
+    obj.filter(data, data + size, output);
+    return result;
+}
+
 auto wrapper_average_filter(edsp::filter::moving_average<real_t>& obj, bn::ndarray& input) {
     return wrapper_filter(obj, input);
 }
@@ -48,6 +70,264 @@ auto wrapper_rms_filter(edsp::filter::moving_rms<real_t>& obj, bn::ndarray& inpu
     return wrapper_filter(obj, input);
 }
 
+auto wrapper_hilbert_filter(edsp::filter::hilbert_filter<real_t>& obj, bn::ndarray& input) {
+    if (input.get_nd() != 1) {
+        throw std::invalid_argument("Expected one-dimensional arrays");
+    }
+    const auto size      = input.shape(0);
+    Py_intptr_t shape[1] = {size};
+    auto result          = bn::empty(1, shape, bn::dtype::get_builtin<std::complex<real_t>>());
+    auto data            = reinterpret_cast<real_t*>(input.get_data());
+    auto output          = reinterpret_cast<std::complex<real_t>*>(result.get_data());
+    obj.filter(data, data + size, output);
+    return result;
+}
+
+// Copies a one-dimensional array, which is filtered in place.
+bn::ndarray copy_vector(const bn::ndarray& input) {
+    if (input.get_nd() != 1) {
+        throw std::invalid_argument("Expected one-dimensional arrays");
+    }
+    const auto size      = input.shape(0);
+    Py_intptr_t shape[1] = {size};
+    auto result          = bn::empty(1, shape, bn::dtype::get_builtin<real_t>());
+    const auto* data     = reinterpret_cast<const real_t*>(input.get_data());
+    std::copy(data, data + size, reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+// Applies forward and backward the second order sections stored in the rows of the matrix, in the [b0, b1, b2, a0,
+// a1, a2] layout of scipy.signal.
+bn::ndarray filtfilt_sos_python(bn::ndarray& input, bn::ndarray& sos) {
+    constexpr std::size_t maximum_sections = 16;
+    if (sos.get_nd() != 2 || sos.shape(1) != 6 || sos.shape(0) < 1 ||
+        static_cast<std::size_t>(sos.shape(0)) > maximum_sections) {
+        throw std::invalid_argument("Expected a matrix of between 1 and 16 second order sections");
+    }
+    auto result        = copy_vector(input);
+    auto* output       = reinterpret_cast<real_t*>(result.get_data());
+    const auto size    = input.shape(0);
+    const auto* values = reinterpret_cast<const real_t*>(sos.get_data());
+    if (sos.shape(0) == 1) {
+        const edsp::filter::biquad<real_t> filter(values[3], values[4], values[5], values[0], values[1], values[2]);
+        edsp::filter::filtfilt(filter, output, output + size);
+        return result;
+    }
+
+    edsp::filter::biquad_cascade<real_t, maximum_sections> cascade;
+    for (Py_intptr_t i = 0; i < sos.shape(0); ++i) {
+        const auto* row = values + 6 * i;
+        cascade.emplace_back(row[3], row[4], row[5], row[0], row[1], row[2]);
+    }
+    edsp::filter::filtfilt(cascade, output, output + size);
+    return result;
+}
+
+// Reads the second order sections stored in the rows of the matrix, in the [b0, b1, b2, a0, a1, a2] layout of
+// scipy.signal.
+std::vector<edsp::filter::biquad<real_t>> read_sections(const bn::ndarray& sos, std::size_t maximum) {
+    if (sos.get_nd() != 2 || sos.shape(1) != 6 || sos.shape(0) < 1 ||
+        static_cast<std::size_t>(sos.shape(0)) > maximum) {
+        throw std::invalid_argument("Expected a matrix of second order sections with 6 columns");
+    }
+    std::vector<edsp::filter::biquad<real_t>> sections;
+    const auto* values = reinterpret_cast<const real_t*>(sos.get_data());
+    for (Py_intptr_t i = 0; i < sos.shape(0); ++i) {
+        const auto* row = values + 6 * i;
+        sections.emplace_back(row[3], row[4], row[5], row[0], row[1], row[2]);
+    }
+    return sections;
+}
+
+// Number of channels of the multichannel filters exposed to Python.
+constexpr std::size_t multichannel_channels = 4;
+
+// Filters the signal with a biquad_cascade of the second order sections stored in the rows of the matrix.
+bn::ndarray sosfilt_python(bn::ndarray& input, bn::ndarray& sos) {
+    edsp::filter::biquad_cascade<real_t, 16> cascade;
+    const auto sections = read_sections(sos, cascade.max_size());
+    auto result         = copy_vector(input);
+    auto* output        = reinterpret_cast<real_t*>(result.get_data());
+    if (sections.size() == 1) {
+        auto filter = sections.front();
+        filter.filter(output, output + input.shape(0), output);
+        return result;
+    }
+
+    for (const auto& section : sections) {
+        cascade.push_back(section);
+    }
+    cascade.filter(output, output + input.shape(0), output);
+    return result;
+}
+
+// Filters every channel of the signal, a matrix of frames x channels, with its own second order section. A single
+// section is replicated in all the channels.
+bn::ndarray multichannel_biquad_python(bn::ndarray& input, bn::ndarray& sos, const std::string& mode) {
+    constexpr auto channels = multichannel_channels;
+    if (mode != "interleaved" && mode != "tick") {
+        throw std::invalid_argument("Expected the interleaved or tick mode");
+    }
+    if (input.get_nd() != 2 || static_cast<std::size_t>(input.shape(1)) != channels) {
+        throw std::invalid_argument("Expected a matrix with 4 channels");
+    }
+
+    const auto sections = read_sections(sos, channels);
+    edsp::filter::multichannel_biquad<real_t, channels> filter(sections.front());
+    if (sections.size() > 1) {
+        if (sections.size() != channels) {
+            throw std::invalid_argument("Expected one section, or one section per channel");
+        }
+        for (std::size_t i = 0; i < channels; ++i) {
+            filter.set(i, sections[i]);
+        }
+    }
+
+    Py_intptr_t shape[2] = {input.shape(0), input.shape(1)};
+    auto result          = bn::zeros(2, shape, bn::dtype::get_builtin<real_t>());
+    const auto* data     = reinterpret_cast<const real_t*>(input.get_data());
+    auto* output         = reinterpret_cast<real_t*>(result.get_data());
+    const auto size      = static_cast<std::size_t>(input.shape(0) * input.shape(1));
+    if (mode == "tick") {
+        for (std::size_t i = 0; i < size; i += channels) {
+            filter.tick(data + i, output + i);
+        }
+    } else {
+        filter.filter(data, data + size, output);
+    }
+    return result;
+}
+
+// Filters every channel of the signal with the same cascade of second order sections. The signal is a matrix of
+// frames x channels for the interleaved and the tick modes, and of channels x frames for the planar mode.
+bn::ndarray multichannel_sosfilt_python(bn::ndarray& input, bn::ndarray& sos, const std::string& mode) {
+    constexpr auto channels = multichannel_channels;
+    const auto planar       = (mode == "planar");
+    if (!planar && mode != "interleaved" && mode != "tick") {
+        throw std::invalid_argument("Expected the interleaved, planar or tick mode");
+    }
+    if (input.get_nd() != 2 || static_cast<std::size_t>(input.shape(planar ? 0 : 1)) != channels) {
+        throw std::invalid_argument("Expected a matrix with 4 channels");
+    }
+
+    edsp::filter::multichannel_biquad_cascade<real_t, 8, channels> cascade;
+    for (const auto& section : read_sections(sos, cascade.max_size())) {
+        cascade.push_back(section);
+    }
+    Py_intptr_t shape[2] = {input.shape(0), input.shape(1)};
+    auto result          = bn::zeros(2, shape, bn::dtype::get_builtin<real_t>());
+    const auto* data     = reinterpret_cast<const real_t*>(input.get_data());
+    auto* output         = reinterpret_cast<real_t*>(result.get_data());
+    const auto size      = static_cast<std::size_t>(input.shape(0) * input.shape(1));
+    if (planar) {
+        const auto frames = static_cast<std::size_t>(input.shape(1));
+        const real_t* inputs[channels];
+        real_t* outputs[channels];
+        for (std::size_t i = 0; i < channels; ++i) {
+            inputs[i]  = data + i * frames;
+            outputs[i] = output + i * frames;
+        }
+        cascade.filter_planar(inputs, outputs, frames);
+    } else if (mode == "tick") {
+        for (std::size_t i = 0; i < size; i += channels) {
+            cascade.tick(data + i, output + i);
+        }
+    } else {
+        cascade.filter(data, data + size, output);
+    }
+    return result;
+}
+
+// Applies forward and backward the FIR filter defined by the taps.
+bn::ndarray filtfilt_fir_python(bn::ndarray& input, bn::ndarray& taps) {
+    if (taps.get_nd() != 1) {
+        throw std::invalid_argument("Expected one-dimensional arrays");
+    }
+    auto result      = copy_vector(input);
+    auto* output     = reinterpret_cast<real_t*>(result.get_data());
+    const auto* b    = reinterpret_cast<const real_t*>(taps.get_data());
+    edsp::filter::filtfilt(b, b + taps.shape(0), output, output + input.shape(0));
+    return result;
+}
+
+template <typename Filter>
+bn::ndarray impulse_response(Filter filter, std::size_t length) {
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(length)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    auto* output         = reinterpret_cast<real_t*>(result.get_data());
+    for (std::size_t i = 0; i < length; ++i) {
+        output[i] = filter.tick((i == 0) ? 1 : 0);
+    }
+    return result;
+}
+
+// Returns the impulse response of a Butterworth low pass filter, realized as a cascade or as a sum of sections.
+bn::ndarray butterworth_lowpass_impulse_python(std::size_t order, real_t sample_rate, real_t cutoff,
+                                               std::size_t length, bool parallel) {
+    using namespace edsp::filter;
+    constexpr std::size_t maximum_order = 32;
+    if (order < 1 || order > maximum_order) {
+        throw std::invalid_argument("Expected an order between 1 and 32");
+    }
+    if (parallel) {
+        return impulse_response(make_parallel_filter<real_t, designer_type::Butterworth, filter_type::LowPass,
+                                                     maximum_order>(order, sample_rate, cutoff),
+                                length);
+    }
+    return impulse_response(
+        make_filter<real_t, designer_type::Butterworth, filter_type::LowPass, maximum_order>(order, sample_rate, cutoff),
+        length);
+}
+
+// Returns the impulse response of a Chebyshev type I band pass filter, realized as a cascade or as a sum of sections.
+bn::ndarray chebyshev_bandpass_impulse_python(std::size_t order, real_t sample_rate, real_t center, real_t bandwidth,
+                                              real_t ripple_db, std::size_t length, bool parallel) {
+    using namespace edsp::filter;
+    constexpr std::size_t maximum_order = 16;
+    if (order < 1 || order > maximum_order) {
+        throw std::invalid_argument("Expected an order between 1 and 16");
+    }
+    if (parallel) {
+        return impulse_response(make_parallel_filter<real_t, designer_type::ChebyshevI, filter_type::BandPass,
+                                                     maximum_order>(order, sample_rate, center, bandwidth, ripple_db),
+                                length);
+    }
+    return impulse_response(make_filter<real_t, designer_type::ChebyshevI, filter_type::BandPass, maximum_order>(
+                                order, sample_rate, center, bandwidth, ripple_db),
+                            length);
+}
+
+// Filters the signal, pushed in chunks of the given size, while the coefficients ramp from the initial section to the
+// target one. Returns the output, the final section and whether the ramp is still running.
+bp::tuple modulated_biquad_python(bn::ndarray& input, bn::ndarray& initial, bn::ndarray& target, std::size_t samples,
+                                  std::size_t chunk) {
+    if (chunk == 0) {
+        throw std::invalid_argument("Expected a positive chunk size");
+    }
+    edsp::filter::modulated_biquad<real_t> filter(read_sections(initial, 1).front());
+    filter.ramp(read_sections(target, 1).front(), samples);
+
+    auto result     = copy_vector(input);
+    auto* output    = reinterpret_cast<real_t*>(result.get_data());
+    const auto size = static_cast<std::size_t>(input.shape(0));
+    for (std::size_t offset = 0; offset < size; offset += chunk) {
+        const auto count = std::min(chunk, size - offset);
+        filter.filter(output + offset, output + offset + count, output + offset);
+    }
+
+    const auto current   = filter.coefficients();
+    Py_intptr_t shape[1] = {6};
+    auto coefficients    = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    auto* values         = reinterpret_cast<real_t*>(coefficients.get_data());
+    values[0]            = current.b0();
+    values[1]            = current.b1();
+    values[2]            = current.b2();
+    values[3]            = current.a0();
+    values[4]            = current.a1();
+    values[5]            = current.a2();
+    return bp::make_tuple(result, coefficients, filter.ramping());
+}
+
 void add_filter_package() {
     std::string nested_name = bp::extract<std::string>(bp::scope().attr("__name__") + ".filter");
     bp::object nested_module(bp::handle<>(bp::borrowed(PyImport_AddModule(nested_name.c_str()))));
@@ -61,6 +341,24 @@ void add_filter_package() {
         .def("__call__", &edsp::filter::moving_median<real_t>::operator())
         .def("filter", wrapper_median_filter);
 
+    bp::class_<edsp::filter::moving_quantile<real_t>, boost::noncopyable>("MovingQuantileFilter",
+                                                                         bp::init<std::size_t, double>())
+        .def("size", &edsp::filter::moving_quantile<real_t>::size)
+        .def("quantile", &edsp::filter::moving_quantile<real_t>::quantile)
+        .def("resize", &edsp::filter::moving_quantile<real_t>::resize)
+        .def("reset", &edsp::filter::moving_quantile<real_t>::reset)
+        .def("__call__", &edsp::filter::moving_quantile<real_t>::operator())
+        .def("filter", wrapper_quantile_filter);
+
+    bp::class_<edsp::filter::moving_quantile<std::int64_t>, boost::noncopyable>("IntegralMovingQuantileFilter",
+                                                                               bp::init<std::size_t, double>())
+        .def("size", &edsp::filter::moving_quantile<std::int64_t>::size)
+        .def("quantile", &edsp::filter::moving_quantile<std::int64_t>::quantile)
+        .def("resize", &edsp::filter::moving_quantile<std::int64_t>::resize)
+        .def("reset", &edsp::filter::moving_quantile<std::int64_t>::reset)
+        .def("__call__", &edsp::filter::moving_quantile<std::int64_t>::operator())
+        .def("filter", wrapper_integral_quantile_filter);
+
     bp::class_<edsp::filter::moving_average<real_t>, boost::noncopyable>("MovingAverageFilter", bp::init<real_t>())
         .def("size", &edsp::filter::moving_average<real_t>::size)
         .def("resize", &edsp::filter::moving_average<real_t>::resize)
@@ -74,4 +372,26 @@ void add_filter_package() {
         .def("reset", &edsp::filter::moving_rms<real_t>::reset)
         .def("__call__", &edsp::filter::moving_rms<real_t>::operator())
         .def("filter", wrapper_rms_filter);
+
+    bp::class_<edsp::filter::hilbert_filter<real_t>, boost::noncopyable>("HilbertFilter", bp::init<std::size_t>())
+        .def("size", &edsp::filter::hilbert_filter<real_t>::size)
+        .def("delay", &edsp::filter::hilbert_filter<real_t>::delay)
+        .def("reset", &edsp::filter::hilbert_filter<real_t>::reset)
+        .def("__call__", &edsp::filter::hilbert_filter<real_t>::operator())
+        .def("filter", wrapper_hilbert_filter);
+
+    bp::def("filtfilt_sos", filtfilt_sos_python);
+    bp::def("filtfilt_fir", filtfilt_fir_python);
+    bp::def("sosfilt", sosfilt_python);
+    bp::def("multichannel_sosfilt", multichannel_sosfilt_python,
+            (bp::arg("data"), bp::arg("sos"), bp::arg("mode") = "interleaved"));
+    bp::def("multichannel_biquad", multichannel_biquad_python,
+            (bp::arg("data"), bp::arg("sos"), bp::arg("mode") = "interleaved"));
+    bp::def("modulated_biquad", modulated_biquad_python);
+    bp::def("butterworth_lowpass_impulse", butterworth_lowpass_impulse_python,
+            (bp::arg("order"), bp::arg("sample_rate"), bp::arg("cutoff"), bp::arg("length"),
+             bp::arg("parallel") = false));
+    bp::def("chebyshev_bandpass_impulse", chebyshev_bandpass_impulse_python,
+            (bp::arg("order"), bp::arg("sample_rate"), bp::arg("center"), bp::arg("bandwidth"), bp::arg("ripple_db"),
+             bp::arg("length"), bp::arg("parallel") = false));
 }
\ No newline at end of file
@@ -48,6 +48,7 @@ BOOST_PYTHON_MODULE(MODULE_NAME) {
     add_feature_temporal_package();
     add_feature_spectral_package();
     add_feature_statistics_package();
+    add_feature_perceptual_package();
     add_filter_package();
     add_io_package();
 }
@@ -23,6 +23,81 @@
 #include "spectral.hpp"
 #include "boost_numpy_dependencies.hpp"
 #include <cedsp/spectral.h>
+#include <edsp/spectral/block_convolver.hpp>
+#include <edsp/spectral/cepstrum.hpp>
+#include <edsp/spectral/constant_q.hpp>
+#include <edsp/spectral/convolution.hpp>
+#include <edsp/spectral/correlation.hpp>
+#include <edsp/spectral/czt.hpp>
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/spectral/goertzel.hpp>
+#include <edsp/spectral/hilbert.hpp>
+#include <edsp/spectral/partitioned_convolver.hpp>
+#include <edsp/spectral/plan_cache.hpp>
+#include <edsp/spectral/sliding_dft.hpp>
+#include <edsp/spectral/split_complex.hpp>
+#include <edsp/spectral/stft.hpp>
+#include <edsp/spectral/welch.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+using complex_type = std::complex<real_t>;
+
+// Split-complex samples stored in a split_complex_buffer, or in two separate arrays, which the backends may need to
+// copy.
+class split_storage {
+public:
+    split_storage(std::size_t size, bool contiguous) :
+        buffer_(contiguous ? size : 0),
+        real_(contiguous ? 0 : size),
+        imag_(contiguous ? 0 : size),
+        size_(size),
+        contiguous_(contiguous) {}
+
+    edsp::split_complex_view<real_t> view() {
+        return contiguous_ ? buffer_.view() : edsp::split_complex_view<real_t>(real_.data(), imag_.data(), size_);
+    }
+
+private:
+    edsp::split_complex_buffer<real_t> buffer_;
+    std::vector<real_t> real_;
+    std::vector<real_t> imag_;
+    std::size_t size_;
+    bool contiguous_;
+};
+
+void deinterleave(const complex_type* input, const edsp::split_complex_view<real_t>& output) {
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        output.real()[i] = input[i].real();
+        output.imag()[i] = input[i].imag();
+    }
+}
+
+void interleave(const edsp::split_complex_view<real_t>& input, complex_type* output) {
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        output[i] = input[i];
+    }
+}
+
+void check_vector(const bn::ndarray& input) {
+    if (input.get_nd() != 1) {
+        throw std::invalid_argument("Expected one-dimensional arrays");
+    }
+}
+
+void check_matrix(const bn::ndarray& input) {
+    if (input.get_nd() != 2) {
+        throw std::invalid_argument("Expected two-dimensional arrays");
+    }
+}
+
+template <typename T>
+bn::ndarray make_matrix(Py_intptr_t rows, Py_intptr_t columns) {
+    Py_intptr_t shape[2] = {rows, columns};
+    return bn::zeros(2, shape, bn::dtype::get_builtin<T>());
+}
 
 template <typename Functor>
 bn::ndarray execute(Functor&& f, bn::ndarray& left, bn::ndarray& right) {
@@ -185,6 +260,568 @@ bn::ndarray cifft_python(bn::ndarray& data) {
     return execute_c2c(complex_ifft, data);
 }
 
+bn::ndarray split_fft_python(bn::ndarray& data, bool contiguous) {
+    check_vector(data);
+    const auto size      = static_cast<std::size_t>(data.shape(0));
+    Py_intptr_t shape[1] = {data.shape(0)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<complex_type>());
+
+    split_storage input(size, contiguous), output(size, contiguous);
+    deinterleave(reinterpret_cast<complex_type*>(data.get_data()), input.view());
+    edsp::fft_engine<real_t> engine(size);
+    engine.dft(input.view(), output.view());
+    interleave(output.view(), reinterpret_cast<complex_type*>(result.get_data()));
+    return result;
+}
+
+bn::ndarray split_ifft_python(bn::ndarray& data, bool contiguous) {
+    check_vector(data);
+    const auto size      = static_cast<std::size_t>(data.shape(0));
+    Py_intptr_t shape[1] = {data.shape(0)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<complex_type>());
+
+    split_storage input(size, contiguous), output(size, contiguous);
+    deinterleave(reinterpret_cast<complex_type*>(data.get_data()), input.view());
+    edsp::fft_engine<real_t> engine(size);
+    engine.idft(input.view(), output.view());
+    auto* result_data = reinterpret_cast<complex_type*>(result.get_data());
+    interleave(output.view(), result_data);
+    engine.idft_scale(result_data);
+    return result;
+}
+
+bn::ndarray split_rfft_python(bn::ndarray& data, bool contiguous) {
+    check_vector(data);
+    const auto size      = static_cast<std::size_t>(data.shape(0));
+    const auto bins      = edsp::make_fft_size(size);
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(bins)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<complex_type>());
+
+    split_storage output(bins, contiguous);
+    edsp::fft_engine<real_t> engine(size);
+    engine.dft(reinterpret_cast<const real_t*>(data.get_data()), output.view());
+    interleave(output.view(), reinterpret_cast<complex_type*>(result.get_data()));
+    return result;
+}
+
+bn::ndarray split_irfft_python(bn::ndarray& data, bool contiguous) {
+    check_vector(data);
+    const auto bins      = static_cast<std::size_t>(data.shape(0));
+    const auto size      = edsp::make_ifft_size(bins);
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(size)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+
+    split_storage input(bins, contiguous);
+    deinterleave(reinterpret_cast<complex_type*>(data.get_data()), input.view());
+    edsp::fft_engine<real_t> engine(size);
+    auto* result_data = reinterpret_cast<real_t*>(result.get_data());
+    engine.idft(input.view(), result_data);
+    engine.idft_scale(result_data);
+    return result;
+}
+
+// Engine transforming copies of the input. The copies are stored at an aligned address or, if requested, one real
+// sample after it, so that the plans of the backends for unaligned buffers are exercised too.
+class fft_engine_python {
+public:
+    explicit fft_engine_python(std::size_t size, edsp::planning_rigor rigor = edsp::planning_rigor::Estimate,
+                               std::size_t threads = 1) :
+        engine_(size, rigor, threads),
+        input_(2 * size + 2),
+        output_(2 * size + 2) {}
+
+    std::size_t size() const {
+        return engine_.size();
+    }
+
+    edsp::planning_rigor rigor() const {
+        return engine_.rigor();
+    }
+
+    std::size_t threads() const {
+        return engine_.threads();
+    }
+
+    bn::ndarray fft(bn::ndarray& data, bool aligned) {
+        auto* input  = prepare<complex_type>(data, engine_.size(), aligned);
+        auto result  = make_vector<complex_type>(engine_.size());
+        auto* output = buffer<complex_type>(output_, aligned);
+        engine_.dft(input, output);
+        return copy(output, result);
+    }
+
+    bn::ndarray ifft(bn::ndarray& data, bool aligned) {
+        auto* input  = prepare<complex_type>(data, engine_.size(), aligned);
+        auto result  = make_vector<complex_type>(engine_.size());
+        auto* output = buffer<complex_type>(output_, aligned);
+        engine_.idft(input, output);
+        engine_.idft_scale(output);
+        return copy(output, result);
+    }
+
+    bn::ndarray rfft(bn::ndarray& data, bool aligned) {
+        auto* input  = prepare<real_t>(data, engine_.size(), aligned);
+        auto result  = make_vector<complex_type>(edsp::make_fft_size(engine_.size()));
+        auto* output = buffer<complex_type>(output_, aligned);
+        engine_.dft(input, output);
+        return copy(output, result);
+    }
+
+    bn::ndarray irfft(bn::ndarray& data, bool aligned) {
+        auto* input  = prepare<complex_type>(data, edsp::make_fft_size(engine_.size()), aligned);
+        auto result  = make_vector<real_t>(engine_.size());
+        auto* output = buffer<real_t>(output_, aligned);
+        engine_.idft(input, output);
+        engine_.idft_scale(output);
+        return copy(output, result);
+    }
+
+    bn::ndarray dct(bn::ndarray& data, bool aligned) {
+        auto* input  = prepare<real_t>(data, engine_.size(), aligned);
+        auto result  = make_vector<real_t>(engine_.size());
+        auto* output = buffer<real_t>(output_, aligned);
+        engine_.dct(input, output);
+        return copy(output, result);
+    }
+
+    bn::ndarray idct(bn::ndarray& data, bool aligned) {
+        auto* input  = prepare<real_t>(data, engine_.size(), aligned);
+        auto result  = make_vector<real_t>(engine_.size());
+        auto* output = buffer<real_t>(output_, aligned);
+        engine_.idct(input, output);
+        engine_.idct_scale(output);
+        return copy(output, result);
+    }
+
+private:
+    template <typename T>
+    static bn::ndarray make_vector(std::size_t size) {
+        Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(size)};
+        return bn::zeros(1, shape, bn::dtype::get_builtin<T>());
+    }
+
+    template <typename T>
+    static T* buffer(edsp::aligned_buffer<complex_type>& storage, bool aligned) {
+        auto* data = reinterpret_cast<real_t*>(storage.data());
+        return reinterpret_cast<T*>(aligned ? data : data + 1);
+    }
+
+    template <typename T>
+    T* prepare(const bn::ndarray& data, std::size_t size, bool aligned) {
+        check_vector(data);
+        if (static_cast<std::size_t>(data.shape(0)) != size) {
+            throw std::invalid_argument("Unexpected number of samples");
+        }
+        auto* input       = buffer<T>(input_, aligned);
+        const auto* first = reinterpret_cast<const T*>(data.get_data());
+        std::copy(first, first + size, input);
+        return input;
+    }
+
+    template <typename T>
+    static bn::ndarray copy(const T* output, bn::ndarray& result) {
+        std::copy(output, output + result.shape(0), reinterpret_cast<T*>(result.get_data()));
+        return result;
+    }
+
+    edsp::fft_engine<real_t> engine_;
+    edsp::aligned_buffer<complex_type> input_;
+    edsp::aligned_buffer<complex_type> output_;
+};
+
+std::size_t default_alignment() {
+    return edsp::default_alignment;
+}
+
+std::size_t fft_alignment() {
+    return edsp::fft_engine<real_t>::alignment();
+}
+
+// Offset, modulo the default alignment, of the storage allocated by aligned_allocator for n elements of type T.
+template <typename T>
+std::size_t aligned_allocation_offset(std::size_t size) {
+    edsp::aligned_allocator<T> allocator;
+    auto* data        = allocator.allocate(size);
+    const auto offset = reinterpret_cast<std::uintptr_t>(data) % edsp::default_alignment;
+    allocator.deallocate(data, size);
+    return offset;
+}
+
+bp::list aligned_allocation_offsets(std::size_t size) {
+    bp::list offsets;
+    offsets.append(aligned_allocation_offset<char>(size));
+    offsets.append(aligned_allocation_offset<float>(size));
+    offsets.append(aligned_allocation_offset<real_t>(size));
+    offsets.append(aligned_allocation_offset<complex_type>(size));
+    return offsets;
+}
+
+// Checks the alignment, as seen by the engine, of real and complex aligned buffers and of a buffer one sample after.
+bp::tuple aligned_buffer_is_aligned(std::size_t size) {
+    using engine = edsp::fft_engine<real_t>;
+    edsp::aligned_buffer<real_t> real(size);
+    edsp::aligned_buffer<complex_type> complex(size);
+    return bp::make_tuple(engine::is_aligned(real.data()), engine::is_aligned(complex.data()),
+                          engine::is_aligned(real.data() + 1));
+}
+
+bool fft_threads_supported() {
+#if defined(USE_LIBFFTW_THREADS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::size_t plan_cache_hits() {
+    return edsp::plan_cache::instance().hits();
+}
+
+std::size_t plan_cache_misses() {
+    return edsp::plan_cache::instance().misses();
+}
+
+std::size_t plan_cache_size() {
+    return edsp::plan_cache::instance().size();
+}
+
+std::size_t plan_cache_capacity() {
+    return edsp::plan_cache::instance().capacity();
+}
+
+void set_plan_cache_capacity(std::size_t capacity) {
+    edsp::plan_cache::instance().set_capacity(capacity);
+}
+
+void clear_plan_cache() {
+    edsp::plan_cache::instance().clear();
+}
+
+void reset_plan_cache_statistics() {
+    edsp::plan_cache::instance().reset_statistics();
+}
+
+std::string export_wisdom() {
+    return edsp::fft_wisdom<real_t>::export_to_string();
+}
+
+bool import_wisdom(const std::string& wisdom) {
+    return edsp::fft_wisdom<real_t>::import_from_string(wisdom);
+}
+
+void forget_wisdom() {
+    edsp::fft_wisdom<real_t>::forget();
+}
+
+// The batched transforms compute the transform of every row of the matrix with a single call.
+bn::ndarray fft_many_python(bn::ndarray& data) {
+    check_matrix(data);
+    auto result = make_matrix<complex_type>(data.shape(0), data.shape(1));
+    edsp::fft_engine<real_t> engine(static_cast<std::size_t>(data.shape(1)));
+    engine.dft_many(reinterpret_cast<const complex_type*>(data.get_data()),
+                    reinterpret_cast<complex_type*>(result.get_data()), static_cast<std::size_t>(data.shape(0)));
+    return result;
+}
+
+bn::ndarray ifft_many_python(bn::ndarray& data) {
+    check_matrix(data);
+    auto result = make_matrix<complex_type>(data.shape(0), data.shape(1));
+    edsp::fft_engine<real_t> engine(static_cast<std::size_t>(data.shape(1)));
+    auto* result_data = reinterpret_cast<complex_type*>(result.get_data());
+    engine.idft_many(reinterpret_cast<const complex_type*>(data.get_data()), result_data,
+                     static_cast<std::size_t>(data.shape(0)));
+    for (Py_intptr_t i = 0; i < data.shape(0); ++i) {
+        engine.idft_scale(result_data + i * data.shape(1));
+    }
+    return result;
+}
+
+bn::ndarray rfft_many_python(bn::ndarray& data) {
+    check_matrix(data);
+    const auto size = static_cast<std::size_t>(data.shape(1));
+    auto result     = make_matrix<complex_type>(data.shape(0), static_cast<Py_intptr_t>(edsp::make_fft_size(size)));
+    edsp::fft_engine<real_t> engine(size);
+    engine.dft_many(reinterpret_cast<const real_t*>(data.get_data()),
+                    reinterpret_cast<complex_type*>(result.get_data()), static_cast<std::size_t>(data.shape(0)));
+    return result;
+}
+
+bn::ndarray irfft_many_python(bn::ndarray& data) {
+    check_matrix(data);
+    const auto size = edsp::make_ifft_size(static_cast<std::size_t>(data.shape(1)));
+    auto result     = make_matrix<real_t>(data.shape(0), static_cast<Py_intptr_t>(size));
+    edsp::fft_engine<real_t> engine(size);
+    auto* result_data = reinterpret_cast<real_t*>(result.get_data());
+    engine.idft_many(reinterpret_cast<const complex_type*>(data.get_data()), result_data,
+                     static_cast<std::size_t>(data.shape(0)));
+    for (Py_intptr_t i = 0; i < data.shape(0); ++i) {
+        engine.idft_scale(result_data + static_cast<std::size_t>(i) * size);
+    }
+    return result;
+}
+
+bn::ndarray czt_python(bn::ndarray& data, std::size_t points, const complex_type& w, const complex_type& a) {
+    check_vector(data);
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(points)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<complex_type>());
+    const auto* input    = reinterpret_cast<const complex_type*>(data.get_data());
+    edsp::czt(input, input + data.shape(0), reinterpret_cast<complex_type*>(result.get_data()), points, w, a);
+    return result;
+}
+
+// Returns the constant-Q transform of a single frame, zero padded up to the FFT size of the transform.
+bn::ndarray cqt_python(bn::ndarray& data, real_t sample_rate, real_t f_min, real_t f_max, std::size_t bins_per_octave,
+                       real_t threshold, real_t gamma) {
+    check_vector(data);
+    edsp::constant_q<real_t> transform(sample_rate, f_min, f_max, bins_per_octave, 1, threshold, gamma);
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(transform.size())};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<complex_type>());
+    const auto* input    = reinterpret_cast<const real_t*>(data.get_data());
+    transform.transform(input, input + data.shape(0), reinterpret_cast<complex_type*>(result.get_data()));
+    return result;
+}
+
+bn::ndarray goertzel_python(bn::ndarray& data, bn::ndarray& frequencies, real_t sample_rate) {
+    check_vector(data);
+    check_vector(frequencies);
+    Py_intptr_t shape[1]  = {frequencies.shape(0)};
+    auto result           = bn::zeros(1, shape, bn::dtype::get_builtin<complex_type>());
+    const auto* input     = reinterpret_cast<const real_t*>(data.get_data());
+    const auto* frequency = reinterpret_cast<const real_t*>(frequencies.get_data());
+    edsp::goertzel_bank<real_t> bank(frequency, frequency + frequencies.shape(0), sample_rate);
+    bank.update(input, input + data.shape(0));
+    bank.dft(reinterpret_cast<complex_type*>(result.get_data()));
+    return result;
+}
+
+// Returns the bins of the DFT of the last window of the stream.
+bn::ndarray sliding_dft_python(bn::ndarray& data, bn::ndarray& bins, std::size_t window_size) {
+    check_vector(data);
+    check_vector(bins);
+    Py_intptr_t shape[1] = {bins.shape(0)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<complex_type>());
+    const auto* input    = reinterpret_cast<const real_t*>(data.get_data());
+    const auto* indexes  = reinterpret_cast<const std::int64_t*>(bins.get_data());
+    edsp::sliding_dft<real_t> transform(indexes, indexes + bins.shape(0), window_size);
+    transform.update(input, input + data.shape(0));
+    transform.dft(reinterpret_cast<complex_type*>(result.get_data()));
+    return result;
+}
+
+// Returns the analytic signal, or only its imaginary part, of every block of the signal, one per row, computed with a
+// single transformer.
+bn::ndarray hilbert_blocks_python(bn::ndarray& data, std::size_t size, bool quadrature) {
+    check_vector(data);
+    edsp::hilbert_transformer<real_t> transformer(size);
+    const auto blocks = static_cast<std::size_t>(data.shape(0)) / size;
+    const auto* input = reinterpret_cast<const real_t*>(data.get_data());
+    if (quadrature) {
+        auto result  = make_matrix<real_t>(static_cast<Py_intptr_t>(blocks), static_cast<Py_intptr_t>(size));
+        auto* output = reinterpret_cast<real_t*>(result.get_data());
+        for (std::size_t i = 0; i < blocks; ++i) {
+            output = transformer.quadrature(input + i * size, input + (i + 1) * size, output);
+        }
+        return result;
+    }
+
+    auto result  = make_matrix<complex_type>(static_cast<Py_intptr_t>(blocks), static_cast<Py_intptr_t>(size));
+    auto* output = reinterpret_cast<complex_type*>(result.get_data());
+    for (std::size_t i = 0; i < blocks; ++i) {
+        output = transformer.process(input + i * size, input + (i + 1) * size, output);
+    }
+    return result;
+}
+
+// Returns the full convolution of the signal and the kernel. The stream is pushed in chunks of different sizes and
+// the latency of the convolver is removed from the output.
+bn::ndarray partitioned_conv_python(bn::ndarray& data, bn::ndarray& kernel, std::size_t block_size) {
+    check_vector(data);
+    check_vector(kernel);
+    const auto size      = static_cast<std::size_t>(data.shape(0) + kernel.shape(0) - 1);
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(size)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    const auto* taps     = reinterpret_cast<const real_t*>(kernel.get_data());
+    edsp::partitioned_convolver<real_t> convolver(taps, taps + kernel.shape(0), block_size);
+
+    std::vector<real_t> input(reinterpret_cast<const real_t*>(data.get_data()),
+                              reinterpret_cast<const real_t*>(data.get_data()) + data.shape(0));
+    input.resize(size + convolver.latency(), 0);
+    std::vector<real_t> output(input.size());
+    for (std::size_t offset = 0, chunk = 1; offset < input.size(); offset += chunk, chunk = chunk * 3 % 17 + 1) {
+        const auto count = std::min(chunk, input.size() - offset);
+        convolver.process(input.data() + offset, input.data() + offset + count, output.data() + offset);
+    }
+    std::copy(output.cbegin() + convolver.latency(), output.cend(), reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+using block_convolver = edsp::block_convolver<real_t>;
+
+block_convolver* make_block_convolver(bn::ndarray& kernel, std::size_t block_size, edsp::convolution_method method) {
+    check_vector(kernel);
+    const auto* taps = reinterpret_cast<const real_t*>(kernel.get_data());
+    return new block_convolver(taps, taps + kernel.shape(0), block_size, method);
+}
+
+// Convolves a chunk of the stream of any length, the history is kept between calls.
+bn::ndarray block_convolver_process_python(block_convolver& convolver, bn::ndarray& data) {
+    check_vector(data);
+    Py_intptr_t shape[1] = {data.shape(0)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    const auto* input    = reinterpret_cast<const real_t*>(data.get_data());
+    convolver.process(input, input + data.shape(0), reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+using convolver         = edsp::convolver<real_t>;
+using correlator        = edsp::correlator<real_t>;
+using cepstrum_analyzer = edsp::cepstrum_analyzer<real_t>;
+
+// Returns the samples of a sequence, which must have the size the class has been created for.
+const real_t* sequence(const bn::ndarray& data, std::size_t size) {
+    check_vector(data);
+    if (static_cast<std::size_t>(data.shape(0)) != size) {
+        throw std::invalid_argument("Unexpected number of samples");
+    }
+    return reinterpret_cast<const real_t*>(data.get_data());
+}
+
+// Calls the functor with the first sample of the input and of an array of the given size, and returns the array.
+template <typename Functor>
+bn::ndarray fixed_size_call(std::size_t size, const bn::ndarray& data, Functor&& functor) {
+    const auto* input    = sequence(data, size);
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(size)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    functor(input, reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+convolver* make_convolver(bn::ndarray& kernel) {
+    check_vector(kernel);
+    const auto* taps = reinterpret_cast<const real_t*>(kernel.get_data());
+    return new convolver(taps, taps + kernel.shape(0));
+}
+
+bn::ndarray convolver_process_python(convolver& instance, bn::ndarray& data) {
+    return fixed_size_call(instance.size(), data, [&instance](const real_t* input, real_t* output) {
+        instance.process(input, input + instance.size(), output);
+    });
+}
+
+bn::ndarray convolver_process_pair_python(convolver& instance, bn::ndarray& left, bn::ndarray& right) {
+    const auto* other = sequence(right, instance.size());
+    return fixed_size_call(instance.size(), left, [&instance, other](const real_t* input, real_t* output) {
+        instance.process(input, input + instance.size(), other, output);
+    });
+}
+
+correlator* make_correlator(bn::ndarray& pattern, edsp::CorrelationScale scale) {
+    check_vector(pattern);
+    const auto* first = reinterpret_cast<const real_t*>(pattern.get_data());
+    return new correlator(first, first + pattern.shape(0), scale);
+}
+
+bn::ndarray correlator_process_python(correlator& instance, bn::ndarray& data) {
+    return fixed_size_call(instance.size(), data, [&instance](const real_t* input, real_t* output) {
+        instance.process(input, input + instance.size(), output);
+    });
+}
+
+bn::ndarray correlator_process_pair_python(correlator& instance, bn::ndarray& left, bn::ndarray& right) {
+    const auto* other = sequence(right, instance.size());
+    return fixed_size_call(instance.size(), left, [&instance, other](const real_t* input, real_t* output) {
+        instance.process(input, input + instance.size(), other, output);
+    });
+}
+
+bn::ndarray correlator_autocorrelate_python(correlator& instance, bn::ndarray& data) {
+    return fixed_size_call(instance.size(), data, [&instance](const real_t* input, real_t* output) {
+        instance.autocorrelate(input, input + instance.size(), output);
+    });
+}
+
+bn::ndarray cepstrum_analyzer_process_python(cepstrum_analyzer& instance, bn::ndarray& data) {
+    return fixed_size_call(instance.size(), data, [&instance](const real_t* input, real_t* output) {
+        instance.process(input, input + instance.size(), output);
+    });
+}
+
+// Returns the spectra of all the frames of the signal, one per row. The stream is pushed in chunks of different sizes.
+bn::ndarray stft_python(bn::ndarray& data, std::size_t frame_size, std::size_t hop_size) {
+    check_vector(data);
+    edsp::stft<real_t> transform(frame_size, hop_size);
+    const auto size    = static_cast<std::size_t>(data.shape(0));
+    const auto rows    = static_cast<Py_intptr_t>(transform.frames(size));
+    const auto columns = static_cast<Py_intptr_t>(transform.bins());
+    auto result        = make_matrix<complex_type>(rows, columns);
+    const auto* input  = reinterpret_cast<const real_t*>(data.get_data());
+    auto* output       = reinterpret_cast<complex_type*>(result.get_data());
+    for (std::size_t offset = 0, chunk = 1; offset < size; offset += chunk, chunk = chunk * 5 % 23 + 1) {
+        const auto count = std::min(chunk, size - offset);
+        output += transform.process(input + offset, input + offset + count, output) * transform.bins();
+    }
+    return result;
+}
+
+// Returns the samples resynthesized from the spectra stored in the rows of the matrix, pushed in batches of
+// different sizes.
+bn::ndarray istft_python(bn::ndarray& data, std::size_t frame_size, std::size_t hop_size) {
+    check_matrix(data);
+    edsp::istft<real_t> transform(frame_size, hop_size);
+    if (static_cast<std::size_t>(data.shape(1)) != transform.bins()) {
+        throw std::invalid_argument("Expected frame_size / 2 + 1 columns");
+    }
+    const auto frames    = static_cast<std::size_t>(data.shape(0));
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(frames * hop_size)};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    const auto* input    = reinterpret_cast<const complex_type*>(data.get_data());
+    auto* output         = reinterpret_cast<real_t*>(result.get_data());
+    for (std::size_t offset = 0, batch = 1; offset < frames; offset += batch, batch = batch % 3 + 1) {
+        const auto count = std::min(batch, frames - offset);
+        output           = transform.process(input + offset * transform.bins(), count, output);
+    }
+    return result;
+}
+
+// Returns the one-sided power spectral density of the signal, pushed in chunks of different sizes.
+bn::ndarray welch_python(bn::ndarray& data, std::size_t segment_size, std::size_t overlap, real_t sample_rate,
+                         edsp::detrend_type detrend, edsp::psd_scaling scaling, edsp::psd_sides sides) {
+    check_vector(data);
+    edsp::welch<real_t> estimator(segment_size, overlap, sample_rate, detrend, scaling, sides);
+    const auto size      = static_cast<std::size_t>(data.shape(0));
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(estimator.bins())};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    const auto* input    = reinterpret_cast<const real_t*>(data.get_data());
+    for (std::size_t offset = 0, chunk = 1; offset < size; offset += chunk, chunk = chunk * 7 % 131 + 1) {
+        const auto count = std::min(chunk, size - offset);
+        estimator.process(input + offset, input + offset + count);
+    }
+    estimator.estimate(reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+using welch = edsp::welch<real_t>;
+
+void welch_process_python(welch& estimator, bn::ndarray& data) {
+    check_vector(data);
+    const auto* input = reinterpret_cast<const real_t*>(data.get_data());
+    estimator.process(input, input + data.shape(0));
+}
+
+bn::ndarray welch_estimate_python(const welch& estimator) {
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(estimator.bins())};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    estimator.estimate(reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
+bn::ndarray welch_frequencies_python(const welch& estimator) {
+    Py_intptr_t shape[1] = {static_cast<Py_intptr_t>(estimator.bins())};
+    auto result          = bn::zeros(1, shape, bn::dtype::get_builtin<real_t>());
+    estimator.frequencies(reinterpret_cast<real_t*>(result.get_data()));
+    return result;
+}
+
 void add_spectral_package() {
     std::string nested_name = bp::extract<std::string>(bp::scope().attr("__name__") + ".spectral");
     bp::object nested_module(bp::handle<>(bp::borrowed(PyImport_AddModule(nested_name.c_str()))));
@@ -194,6 +831,26 @@ void add_spectral_package() {
     bp::def("conv", conv_python);
     bp::def("xcorr", correlation_python);
     bp::def("cepstrum", cepstrum_python);
+    bp::class_<convolver, boost::noncopyable>("Convolver", bp::init<std::size_t>())
+        .def("__init__", bp::make_constructor(make_convolver))
+        .def("size", &convolver::size)
+        .def("process", convolver_process_python)
+        .def("process", convolver_process_pair_python);
+    bp::enum_<edsp::CorrelationScale>("CorrelationScale")
+        .value("Unscaled", edsp::CorrelationScale::None)
+        .value("Biased", edsp::CorrelationScale::Biased)
+        .value("Unbiased", edsp::CorrelationScale::Unbiased);
+    bp::class_<correlator, boost::noncopyable>("Correlator", bp::init<std::size_t, bp::optional<edsp::CorrelationScale>>())
+        .def("__init__", bp::make_constructor(make_correlator, bp::default_call_policies(),
+                                              (bp::arg("pattern"), bp::arg("scale") = edsp::CorrelationScale::None)))
+        .def("size", &correlator::size)
+        .def("scale", &correlator::scale)
+        .def("autocorrelate", correlator_autocorrelate_python)
+        .def("process", correlator_process_python)
+        .def("process", correlator_process_pair_python);
+    bp::class_<cepstrum_analyzer, boost::noncopyable>("CepstrumAnalyzer", bp::init<std::size_t>())
+        .def("size", &cepstrum_analyzer::size)
+        .def("process", cepstrum_analyzer_process_python);
     bp::def("dct", dct_python);
     bp::def("idct", idct_python);
     bp::def("spectrum", spectrum_python);
@@ -203,4 +860,92 @@ void add_spectral_package() {
     bp::def("irfft", ifft_python);
     bp::def("fft", cfft_python);
     bp::def("ifft", cifft_python);
+    bp::def("split_fft", split_fft_python, (bp::arg("data"), bp::arg("contiguous") = true));
+    bp::def("split_ifft", split_ifft_python, (bp::arg("data"), bp::arg("contiguous") = true));
+    bp::def("split_rfft", split_rfft_python, (bp::arg("data"), bp::arg("contiguous") = true));
+    bp::def("split_irfft", split_irfft_python, (bp::arg("data"), bp::arg("contiguous") = true));
+    bp::enum_<edsp::planning_rigor>("PlanningRigor")
+        .value("Estimate", edsp::planning_rigor::Estimate)
+        .value("Measure", edsp::planning_rigor::Measure)
+        .value("Patient", edsp::planning_rigor::Patient)
+        .value("Exhaustive", edsp::planning_rigor::Exhaustive);
+    bp::class_<fft_engine_python, boost::noncopyable>("FFTEngine",
+                                                      bp::init<std::size_t, bp::optional<edsp::planning_rigor, std::size_t>>())
+        .def("size", &fft_engine_python::size)
+        .def("rigor", &fft_engine_python::rigor)
+        .def("threads", &fft_engine_python::threads)
+        .def("fft", &fft_engine_python::fft, (bp::arg("data"), bp::arg("aligned") = true))
+        .def("ifft", &fft_engine_python::ifft, (bp::arg("data"), bp::arg("aligned") = true))
+        .def("rfft", &fft_engine_python::rfft, (bp::arg("data"), bp::arg("aligned") = true))
+        .def("irfft", &fft_engine_python::irfft, (bp::arg("data"), bp::arg("aligned") = true))
+        .def("dct", &fft_engine_python::dct, (bp::arg("data"), bp::arg("aligned") = true))
+        .def("idct", &fft_engine_python::idct, (bp::arg("data"), bp::arg("aligned") = true));
+    bp::def("default_alignment", default_alignment);
+    bp::def("fft_alignment", fft_alignment);
+    bp::def("aligned_allocation_offsets", aligned_allocation_offsets);
+    bp::def("aligned_buffer_is_aligned", aligned_buffer_is_aligned);
+    bp::def("fft_threads_supported", fft_threads_supported);
+    bp::def("plan_cache_hits", plan_cache_hits);
+    bp::def("plan_cache_misses", plan_cache_misses);
+    bp::def("plan_cache_size", plan_cache_size);
+    bp::def("plan_cache_capacity", plan_cache_capacity);
+    bp::def("set_plan_cache_capacity", set_plan_cache_capacity);
+    bp::def("clear_plan_cache", clear_plan_cache);
+    bp::def("reset_plan_cache_statistics", reset_plan_cache_statistics);
+    bp::def("export_wisdom", export_wisdom);
+    bp::def("import_wisdom", import_wisdom);
+    bp::def("forget_wisdom", forget_wisdom);
+    bp::def("fft_many", fft_many_python);
+    bp::def("ifft_many", ifft_many_python);
+    bp::def("rfft_many", rfft_many_python);
+    bp::def("irfft_many", irfft_many_python);
+    bp::def("czt", czt_python, (bp::arg("data"), bp::arg("points"), bp::arg("w"), bp::arg("a") = complex_type(1, 0)));
+    bp::def("cqt", cqt_python,
+            (bp::arg("data"), bp::arg("sample_rate"), bp::arg("f_min"), bp::arg("f_max"), bp::arg("bins_per_octave"),
+             bp::arg("threshold") = 0.0054, bp::arg("gamma") = 0));
+    bp::def("goertzel", goertzel_python);
+    bp::def("sliding_dft", sliding_dft_python);
+    bp::def("hilbert_blocks", hilbert_blocks_python, (bp::arg("data"), bp::arg("size"), bp::arg("quadrature") = false));
+    bp::def("partitioned_conv", partitioned_conv_python);
+    bp::enum_<edsp::convolution_method>("ConvolutionMethod")
+        .value("OverlapSave", edsp::convolution_method::OverlapSave)
+        .value("OverlapAdd", edsp::convolution_method::OverlapAdd);
+    bp::class_<block_convolver, boost::noncopyable>("BlockConvolver", bp::no_init)
+        .def("__init__", bp::make_constructor(make_block_convolver, bp::default_call_policies(),
+                                              (bp::arg("kernel"), bp::arg("block_size"),
+                                               bp::arg("method") = edsp::convolution_method::OverlapSave)))
+        .def("kernel_size", &block_convolver::kernel_size)
+        .def("block_size", &block_convolver::block_size)
+        .def("fft_size", &block_convolver::fft_size)
+        .def("method", &block_convolver::method)
+        .def("reset", &block_convolver::reset)
+        .def("process", block_convolver_process_python);
+    bp::def("stft", stft_python);
+    bp::def("istft", istft_python);
+    bp::enum_<edsp::detrend_type>("DetrendType")
+        .value("NoDetrend", edsp::detrend_type::None)
+        .value("Constant", edsp::detrend_type::Constant)
+        .value("Linear", edsp::detrend_type::Linear);
+    bp::enum_<edsp::psd_scaling>("PsdScaling")
+        .value("Density", edsp::psd_scaling::Density)
+        .value("Spectrum", edsp::psd_scaling::Spectrum);
+    bp::enum_<edsp::psd_sides>("PsdSides")
+        .value("OneSided", edsp::psd_sides::OneSided)
+        .value("TwoSided", edsp::psd_sides::TwoSided);
+    bp::def("welch", welch_python,
+            (bp::arg("data"), bp::arg("segment_size"), bp::arg("overlap"), bp::arg("sample_rate"),
+             bp::arg("detrend") = edsp::detrend_type::Constant, bp::arg("scaling") = edsp::psd_scaling::Density,
+             bp::arg("sides") = edsp::psd_sides::OneSided));
+    bp::class_<welch, boost::noncopyable>(
+        "Welch", bp::init<std::size_t, std::size_t, bp::optional<real_t, edsp::detrend_type, edsp::psd_scaling,
+                                                                 edsp::psd_sides>>())
+        .def("segment_size", &welch::segment_size)
+        .def("overlap", &welch::overlap)
+        .def("sample_rate", &welch::sample_rate)
+        .def("bins", &welch::bins)
+        .def("segments", &welch::segments)
+        .def("reset", &welch::reset)
+        .def("process", welch_process_python)
+        .def("estimate", welch_estimate_python)
+        .def("frequencies", welch_frequencies_python);
 }
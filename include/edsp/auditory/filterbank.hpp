@@ -0,0 +1,300 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: filterbank.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_FILTERBANK_HPP
+#define EDSP_FILTERBANK_HPP
+
+#include <edsp/auditory/audspace.hpp>
+#include <edsp/auditory/converter/mel2hertz.hpp>
+#include <edsp/auditory/converter/erb2hertz.hpp>
+#include <edsp/auditory/converter/bark2hertz.hpp>
+#include <edsp/auditory/converter/cent2hertz.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/data.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace edsp { namespace auditory {
+
+    /**
+     * @brief The filterbank_shape enum defines the frequency response of the bands of a filterbank.
+     */
+    enum class filterbank_shape {
+        Triangular, /*!< Overlapping triangles, from the center of the previous band to the center of the next one */
+        Gammatone   /*!< Power response of a 4th order gammatone filter, with a bandwidth of 1.019 ERB */
+    };
+
+    namespace internal {
+
+        template <typename T>
+        inline T to_auditory(T frequency, auditory_scale scale) {
+            switch (scale) {
+                case auditory_scale::mel:
+                    return converter::hertz2mel(frequency);
+                case auditory_scale::erb:
+                    return converter::hertz2erb(frequency);
+                case auditory_scale::bark:
+                    return converter::hertz2bark(frequency);
+                case auditory_scale::cent:
+                    return converter::hertz2cent(frequency);
+            }
+            return frequency;
+        }
+
+        template <typename T>
+        inline T from_auditory(T value, auditory_scale scale) {
+            switch (scale) {
+                case auditory_scale::mel:
+                    return converter::mel2hertz(value);
+                case auditory_scale::erb:
+                    return converter::erb2hertz(value);
+                case auditory_scale::bark:
+                    return converter::bark2hertz(value);
+                case auditory_scale::cent:
+                    return converter::cent2hertz(value);
+            }
+            return value;
+        }
+
+    } // namespace internal
+
+    /**
+     * @class filterbank
+     * @brief This class implements a filterbank of bands uniformly spaced on an auditory scale, applied to the power
+     * spectrum of a real signal, as used to compute log-mel spectrograms, MFCCs or auditory spectra.
+     *
+     * The weights of every band are computed once for a given FFT size and sample rate. Only the non-zero weights
+     * are stored, as a contiguous run of bins per band, so applying the filterbank costs a short dot product per band
+     * instead of a dense bins x bands matrix product.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the weights, defaults to aligned_allocator<T>.
+     * @see auditory_scale, filterbank_shape
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class filterbank {
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Creates a %filterbank.
+         * @param bands Number of bands.
+         * @param nfft Size of the FFT, the power spectra have nfft / 2 + 1 bins.
+         * @param sample_rate Sampling frequency in Hz.
+         * @param f_min Lowest frequency of the filterbank, in Hz.
+         * @param f_max Highest frequency of the filterbank, in Hz.
+         * @param scale Auditory scale used to space the bands.
+         * @param shape Frequency response of the bands.
+         * @param normalized If true, the weights of every band are scaled to sum one.
+         */
+        filterbank(size_type bands, size_type nfft, value_type sample_rate, value_type f_min, value_type f_max,
+                   auditory_scale scale = auditory_scale::mel, filterbank_shape shape = filterbank_shape::Triangular,
+                   bool normalized = false);
+
+        /**
+         * @brief Returns the number of bands.
+         */
+        size_type size() const noexcept;
+
+        /**
+         * @brief Returns the number of bins of the power spectra.
+         */
+        size_type bins() const noexcept;
+
+        /**
+         * @brief Returns the number of non-zero weights stored.
+         */
+        size_type nonzeros() const noexcept;
+
+        /**
+         * @brief Computes the center frequencies, in Hz, of the bands and stores the result in another range,
+         * beginning at d_first.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for size()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt frequencies(OutputIt d_first) const;
+
+        /**
+         * @brief Computes the dense weights of all the bands, a matrix of size() rows and bins() columns in row-major
+         * order, and stores the result in another range, beginning at d_first.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt weights(OutputIt d_first) const;
+
+        /**
+         * @brief Applies the filterbank to the power spectrum stored in the range [first, last) and stores the energy
+         * of every band in another range, beginning at d_first.
+         * @param first Random access iterator defining the beginning of the power spectrum.
+         * @param last Random access iterator defining the ending of the power spectrum, it should have bins() elements.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for size()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename RandomIt, typename OutputIt>
+        OutputIt apply(RandomIt first, RandomIt last, OutputIt d_first) const;
+
+    private:
+        std::vector<value_type, Allocator> centers_;
+        std::vector<value_type, Allocator> weights_;
+        // The weights of the band k are stored in [offsets_[k], offsets_[k + 1]) and applied to the bins beginning
+        // at starts_[k].
+        std::vector<size_type> starts_;
+        std::vector<size_type> offsets_;
+        size_type bins_;
+    };
+
+    template <typename T, typename Allocator>
+    filterbank<T, Allocator>::filterbank(size_type bands, size_type nfft, value_type sample_rate, value_type f_min,
+                                         value_type f_max, auditory_scale scale, filterbank_shape shape,
+                                         bool normalized) :
+        centers_(bands),
+        starts_(bands),
+        offsets_(1, 0),
+        bins_(nfft / 2 + 1) {
+        meta::expects(bands > 0, "Expecting at least one band");
+        meta::expects(nfft > 0, "Expecting a non-empty FFT");
+        meta::expects(sample_rate > 0, "The sample rate must be positive");
+        meta::expects(f_min >= 0 && f_min < f_max, "Expecting a valid frequency range");
+        meta::expects(f_max <= sample_rate / 2, "The maximum frequency must be below the Nyquist frequency");
+        meta::expects(scale != auditory_scale::cent || f_min > 0, "The Cent scale is not defined at 0 Hz");
+
+        // The triangles need the edges of the first and last bands, the gammatone responses only their centers.
+        const auto triangular = shape == filterbank_shape::Triangular;
+        const auto points     = triangular ? bands + 2 : bands;
+        const auto lower      = internal::to_auditory(f_min, scale);
+        const auto upper      = internal::to_auditory(f_max, scale);
+        const auto step       = (points > 1) ? (upper - lower) / static_cast<value_type>(points - 1) : 0;
+        std::vector<value_type, Allocator> edges(points);
+        for (size_type i = 0; i < points; ++i) {
+            edges[i] = internal::from_auditory(lower + step * static_cast<value_type>(i), scale);
+        }
+
+        const auto resolution = sample_rate / static_cast<value_type>(nfft);
+        std::vector<value_type, Allocator> response(bins_);
+        for (size_type k = 0; k < bands; ++k) {
+            if (triangular) {
+                const auto left   = edges[k];
+                const auto center = edges[k + 1];
+                const auto right  = edges[k + 2];
+                centers_[k]       = center;
+                for (size_type j = 0; j < bins_; ++j) {
+                    const auto f   = resolution * static_cast<value_type>(j);
+                    const auto up  = (f - left) / (center - left);
+                    const auto low = (right - f) / (right - center);
+                    response[j]    = std::max(static_cast<value_type>(0), std::min(up, low));
+                }
+            } else {
+                // The 4th order gammatone filter has a magnitude response of (1 + ((f - fc) / b)^2)^(-2).
+                const auto center    = edges[k];
+                const auto bandwidth = static_cast<value_type>(1.019 * 24.7 * (4.37 * center / 1000 + 1));
+                const auto cutoff    = static_cast<value_type>(1e-4);
+                centers_[k]          = center;
+                for (size_type j = 0; j < bins_; ++j) {
+                    const auto x      = (resolution * static_cast<value_type>(j) - center) / bandwidth;
+                    const auto weight = std::pow(1 + x * x, static_cast<value_type>(-4));
+                    response[j]       = (weight > cutoff) ? weight : static_cast<value_type>(0);
+                }
+            }
+
+            const auto is_zero = [](value_type w) { return w == 0; };
+            const auto begin   = std::find_if_not(std::cbegin(response), std::cend(response), is_zero);
+            const auto end     = std::find_if_not(std::crbegin(response), std::crend(response), is_zero).base();
+            starts_[k]         = static_cast<size_type>(std::distance(std::cbegin(response), begin));
+            if (begin < end) {
+                const auto first = weights_.size();
+                weights_.insert(std::end(weights_), begin, end);
+                if (normalized) {
+                    const auto sum = std::accumulate(std::begin(weights_) + first, std::end(weights_),
+                                                     static_cast<value_type>(0));
+                    std::transform(std::begin(weights_) + first, std::end(weights_), std::begin(weights_) + first,
+                                   [sum](value_type w) { return w / sum; });
+                }
+            }
+            offsets_.push_back(weights_.size());
+        }
+    }
+
+    template <typename T, typename Allocator>
+    typename filterbank<T, Allocator>::size_type filterbank<T, Allocator>::size() const noexcept {
+        return centers_.size();
+    }
+
+    template <typename T, typename Allocator>
+    typename filterbank<T, Allocator>::size_type filterbank<T, Allocator>::bins() const noexcept {
+        return bins_;
+    }
+
+    template <typename T, typename Allocator>
+    typename filterbank<T, Allocator>::size_type filterbank<T, Allocator>::nonzeros() const noexcept {
+        return weights_.size();
+    }
+
+    template <typename T, typename Allocator>
+    template <typename OutputIt>
+    OutputIt filterbank<T, Allocator>::frequencies(OutputIt d_first) const {
+        return std::copy(std::cbegin(centers_), std::cend(centers_), d_first);
+    }
+
+    template <typename T, typename Allocator>
+    template <typename OutputIt>
+    OutputIt filterbank<T, Allocator>::weights(OutputIt d_first) const {
+        for (size_type k = 0, size = centers_.size(); k < size; ++k) {
+            const auto length = offsets_[k + 1] - offsets_[k];
+            for (size_type j = 0; j < bins_; ++j, ++d_first) {
+                const auto inside = j >= starts_[k] && j < starts_[k] + length;
+                *d_first          = inside ? weights_[offsets_[k] + j - starts_[k]] : static_cast<value_type>(0);
+            }
+        }
+        return d_first;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename RandomIt, typename OutputIt>
+    OutputIt filterbank<T, Allocator>::apply(RandomIt first, RandomIt last, OutputIt d_first) const {
+        meta::expects(static_cast<size_type>(std::distance(first, last)) == bins_,
+                      "The size of the spectrum does not match the filterbank");
+        const auto* weights = meta::data(weights_);
+        for (size_type k = 0, size = centers_.size(); k < size; ++k, ++d_first) {
+            const auto* w       = weights + offsets_[k];
+            const auto length   = offsets_[k + 1] - offsets_[k];
+            const auto spectrum = first + static_cast<std::ptrdiff_t>(starts_[k]);
+            auto accumulated    = static_cast<value_type>(0);
+            for (size_type j = 0; j < length; ++j) {
+                accumulated += w[j] * spectrum[static_cast<std::ptrdiff_t>(j)];
+            }
+            *d_first = accumulated;
+        }
+        return d_first;
+    }
+
+}} // namespace edsp::auditory
+
+#endif //EDSP_FILTERBANK_HPP
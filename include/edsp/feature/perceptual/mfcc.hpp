@@ -0,0 +1,351 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: mfcc.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_MFCC_HPP
+#define EDSP_MFCC_HPP
+
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/auditory/filterbank.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/windowing/hanning.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/data.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace edsp { namespace feature { inline namespace perceptual {
+
+    /**
+     * @class mfcc
+     * @brief This class extracts the Mel-Frequency Cepstral Coefficients (MFCC) of a stream of samples.
+     *
+     * Every hop_size() samples, a frame of frame_size() samples is weighted by a Hann window and the following
+     * pipeline is applied:
+     *  - power spectrum of the frame,
+     *  - energy of every band of a triangular Mel filterbank,
+     *  - natural logarithm of the energies,
+     *  - orthonormal DCT-II, keeping the first coefficients,
+     *  - optional sinusoidal liftering: \f$ c_n \left(1 + \frac{L}{2} \sin\left(\frac{\pi n}{L}\right)\right) \f$.
+     *
+     * Optionally, the delta and delta-delta coefficients are appended to every frame, computed with the regression
+     * formula over the W previous and next frames:
+     *
+     * \f[
+     *  d_t = \frac{\sum_{n=1}^{W} n (c_{t+n} - c_{t-n})}{2 \sum_{n=1}^{W} n^2}
+     * \f]
+     *
+     * As they depend on future frames, every frame is emitted latency() frames after being computed. The first frame
+     * of the stream is replicated to compute the regression of the first ones, and flush() replicates the last one to
+     * emit the frames still pending at the end of the stream.
+     *
+     * All the plans and buffers are created in the constructor, so processing the stream does not allocate.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the internal buffers, defaults to aligned_allocator<T>.
+     * @see auditory::filterbank
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class mfcc {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %mfcc extractor.
+         * @param sample_rate Sampling frequency in Hz.
+         * @param frame_size Number of samples of every analysis frame.
+         * @param hop_size Number of samples between the beginning of two consecutive frames.
+         * @param bands Number of bands of the Mel filterbank.
+         * @param coefficients Number of cepstral coefficients, at most the number of bands.
+         * @param f_min Lowest frequency of the filterbank, in Hz.
+         * @param f_max Highest frequency of the filterbank, in Hz. Zero selects the Nyquist frequency.
+         * @param lifter Liftering parameter L, zero to disable the liftering.
+         * @param order Number of regression coefficients appended to every frame: 0, 1 (deltas) or 2 (deltas and
+         * delta-deltas).
+         * @param width Number of frames W at each side of the regression window.
+         */
+        mfcc(value_type sample_rate, size_type frame_size, size_type hop_size, size_type bands = 40,
+             size_type coefficients = 13, value_type f_min = 0, value_type f_max = 0, value_type lifter = 0,
+             size_type order = 0, size_type width = 2) :
+            window_(frame_size),
+            buffer_(frame_size, static_cast<value_type>(0)),
+            frame_(frame_size),
+            spectrum_(make_fft_size(frame_size)),
+            power_(make_fft_size(frame_size)),
+            energies_(bands),
+            cepstrum_(bands),
+            scaling_(coefficients),
+            history_((2 * width * order + 1) * coefficients),
+            deltas_((order == 2) ? (2 * width + 1) * coefficients : 0),
+            filterbank_(bands, frame_size, sample_rate, f_min, (f_max > 0) ? f_max : sample_rate / 2),
+            fft_(frame_size),
+            dct_(bands),
+            hop_(hop_size),
+            order_(order),
+            width_(width) {
+            meta::expects(hop_size > 0 && hop_size <= frame_size, "The hop size must be in the range [1, frame_size]");
+            meta::expects(coefficients > 0 && coefficients <= bands,
+                          "The number of coefficients must be in the range [1, bands]");
+            meta::expects(order <= 2, "The regression order must be 0, 1 or 2");
+            meta::expects(order == 0 || width > 0, "The regression window can not be empty");
+            windowing::hanning(std::begin(window_), std::end(window_));
+
+            // The DCT computed by the engine is scaled by 2: the orthonormal scaling and the lifter are folded in.
+            const auto size = static_cast<value_type>(bands);
+            for (size_type n = 0; n < coefficients; ++n) {
+                const auto normalization = std::sqrt(static_cast<value_type>((n == 0) ? 1 : 2) / size) / 2;
+                scaling_[n]              = normalization;
+                if (lifter > 0) {
+                    const auto angle = constants<value_type>::pi * static_cast<value_type>(n) / lifter;
+                    scaling_[n] *= 1 + lifter / 2 * std::sin(angle);
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the number of samples of every analysis frame.
+         */
+        inline size_type frame_size() const noexcept {
+            return window_.size();
+        }
+
+        /**
+         * @brief Returns the number of samples between the beginning of two consecutive frames.
+         */
+        inline size_type hop_size() const noexcept {
+            return hop_;
+        }
+
+        /**
+         * @brief Returns the number of cepstral coefficients.
+         */
+        inline size_type coefficients() const noexcept {
+            return scaling_.size();
+        }
+
+        /**
+         * @brief Returns the number of values of every emitted frame: the cepstral coefficients, followed by the
+         * deltas and the delta-deltas, if enabled.
+         */
+        inline size_type features() const noexcept {
+            return scaling_.size() * (order_ + 1);
+        }
+
+        /**
+         * @brief Returns the number of frames between the computation of a frame and its emission.
+         */
+        inline size_type latency() const noexcept {
+            return width_ * order_;
+        }
+
+        /**
+         * @brief Returns the number of frames emitted if the given number of samples is pushed.
+         *
+         * Use it to size the output matrix: it should have at least frames(N) * features() elements.
+         * @param samples Number of samples to be pushed.
+         * @returns Number of emitted frames.
+         */
+        inline size_type frames(size_type samples) const noexcept {
+            const auto available = filled_ + samples;
+            const auto computed  = (available < window_.size()) ? 0 : (available - window_.size()) / hop_ + 1;
+            return emitted(computed_ + computed) - emitted(computed_);
+        }
+
+        /**
+         * @brief Returns the number of computed frames that have not been emitted yet, all of them emitted by flush().
+         */
+        inline size_type pending() const noexcept {
+            return computed_ - emitted(computed_);
+        }
+
+        /**
+         * @brief Discards the buffered samples and frames.
+         */
+        inline void reset() {
+            std::fill(std::begin(buffer_), std::end(buffer_), static_cast<value_type>(0));
+            filled_   = 0;
+            computed_ = 0;
+        }
+
+        /**
+         * @brief Pushes the samples in the range [first, last) and computes the features of every completed frame.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Pointer to the beginning of the output matrix, with room for frames(N) * features() elements.
+         * @returns Number of emitted frames.
+         */
+        template <typename InputIt>
+        size_type process(InputIt first, InputIt last, value_type* d_first) {
+            const auto size = window_.size();
+            size_type emitted{0};
+            while (first != last) {
+                const auto missing   = static_cast<std::ptrdiff_t>(size - filled_);
+                const auto available = std::distance(first, last);
+                const auto count     = std::min(missing, static_cast<std::ptrdiff_t>(available));
+                auto next            = std::next(first, count);
+                std::copy(first, next, std::begin(buffer_) + filled_);
+                filled_ += static_cast<size_type>(count);
+                first = next;
+
+                if (filled_ == size) {
+                    compute();
+                    if (computed_ > latency()) {
+                        emit(d_first + emitted * features());
+                        ++emitted;
+                    }
+                    std::copy(std::begin(buffer_) + hop_, std::end(buffer_), std::begin(buffer_));
+                    filled_ = size - hop_;
+                }
+            }
+            return emitted;
+        }
+
+        /**
+         * @brief Ends the stream: emits the pending() frames, replicating the last computed frame as many times as
+         * needed to compute their regression, and discards the state as reset().
+         *
+         * The samples of an incomplete frame are discarded.
+         * @param d_first Pointer to the beginning of the output matrix, with room for pending() * features() elements.
+         * @returns Number of emitted frames.
+         */
+        size_type flush(value_type* d_first) {
+            const auto count        = pending();
+            const auto coefficients = static_cast<std::ptrdiff_t>(scaling_.size());
+            // A stream shorter than latency() frames is shifted until its first frame reaches the center.
+            for (auto i = computed_; i < latency(); ++i) {
+                std::copy(std::begin(history_) + coefficients, std::end(history_), std::begin(history_));
+            }
+            for (size_type i = 0; i < count; ++i) {
+                // Shifting the history leaves the newest cepstrum in its place, so it is replicated.
+                std::copy(std::begin(history_) + coefficients, std::end(history_), std::begin(history_));
+                emit(d_first + i * features());
+            }
+            reset();
+            return count;
+        }
+
+    private:
+        inline size_type emitted(size_type computed) const noexcept {
+            return (computed > latency()) ? computed - latency() : 0;
+        }
+
+        // Computes the cepstrum of the buffered frame and pushes it into the history.
+        void compute() {
+            std::transform(std::cbegin(buffer_), std::cend(buffer_), std::cbegin(window_), std::begin(frame_),
+                           std::multiplies<value_type>());
+            fft_.dft(meta::data(frame_), meta::data(spectrum_));
+            std::transform(std::cbegin(spectrum_), std::cend(spectrum_), std::begin(power_),
+                           [](const complex_type& x) { return std::norm(x); });
+            filterbank_.apply(std::cbegin(power_), std::cend(power_), std::begin(energies_));
+
+            std::transform(std::cbegin(energies_), std::cend(energies_), std::begin(energies_),
+                           [](value_type x) { return std::log(std::max(x, static_cast<value_type>(1e-10))); });
+            dct_.dct(meta::data(energies_), meta::data(cepstrum_));
+
+            // The history stores the cepstra from the oldest to the newest one. It is filled with the first cepstrum
+            // of the stream, so the regression of the first frames replicates it.
+            const auto coefficients = scaling_.size();
+            const auto newest       = std::end(history_) - static_cast<std::ptrdiff_t>(coefficients);
+            std::copy(std::begin(history_) + static_cast<std::ptrdiff_t>(coefficients), std::end(history_),
+                      std::begin(history_));
+            std::transform(std::cbegin(cepstrum_), std::cbegin(cepstrum_) + static_cast<std::ptrdiff_t>(coefficients),
+                           std::cbegin(scaling_), newest, std::multiplies<value_type>());
+            if (computed_ == 0) {
+                for (auto it = std::begin(history_); it != newest; it += static_cast<std::ptrdiff_t>(coefficients)) {
+                    std::copy(newest, std::end(history_), it);
+                }
+            }
+            ++computed_;
+        }
+
+        // Computes the regression of the frames in [center - W, center + W] of the given matrix.
+        void regression(const value_type* frames, size_type center, value_type* d_first) const {
+            const auto coefficients = scaling_.size();
+            auto denominator        = static_cast<value_type>(0);
+            std::fill(d_first, d_first + coefficients, static_cast<value_type>(0));
+            for (size_type n = 1; n <= width_; ++n) {
+                const auto* next     = frames + (center + n) * coefficients;
+                const auto* previous = frames + (center - n) * coefficients;
+                const auto weight    = static_cast<value_type>(n);
+                for (size_type i = 0; i < coefficients; ++i) {
+                    d_first[i] += weight * (next[i] - previous[i]);
+                }
+                denominator += 2 * weight * weight;
+            }
+            std::transform(d_first, d_first + coefficients, d_first,
+                           [denominator](value_type x) { return x / denominator; });
+        }
+
+        // Emits the features of the frame in the middle of the history.
+        void emit(value_type* d_first) {
+            const auto coefficients = scaling_.size();
+            const auto center       = latency();
+            const auto* history     = meta::data(history_);
+            std::copy(history + center * coefficients, history + (center + 1) * coefficients, d_first);
+            if (order_ == 1) {
+                regression(history, center, d_first + coefficients);
+            } else if (order_ == 2) {
+                // The delta-deltas need the deltas of all the frames in [center - W, center + W].
+                auto* deltas = d_first + coefficients;
+                regression(history, center, deltas);
+                for (size_type n = 0; n <= 2 * width_; ++n) {
+                    if (n != width_) {
+                        regression(history, width_ + n, meta::data(deltas_) + n * coefficients);
+                    } else {
+                        std::copy(deltas, deltas + coefficients, meta::data(deltas_) + n * coefficients);
+                    }
+                }
+                regression(meta::data(deltas_), width_, d_first + 2 * coefficients);
+            }
+        }
+
+        std::vector<value_type, Allocator> window_;
+        std::vector<value_type, Allocator> buffer_;
+        std::vector<value_type, Allocator> frame_;
+        std::vector<complex_type, typename std::allocator_traits<Allocator>::template rebind_alloc<complex_type>>
+            spectrum_;
+        std::vector<value_type, Allocator> power_;
+        std::vector<value_type, Allocator> energies_;
+        std::vector<value_type, Allocator> cepstrum_;
+        std::vector<value_type, Allocator> scaling_;
+        std::vector<value_type, Allocator> history_;
+        std::vector<value_type, Allocator> deltas_;
+        auditory::filterbank<value_type, Allocator> filterbank_;
+        fft_engine<value_type> fft_;
+        fft_engine<value_type> dct_;
+        size_type hop_;
+        size_type order_;
+        size_type width_;
+        size_type filled_{0};
+        size_type computed_{0};
+    };
+
+}}} // namespace edsp::feature::perceptual
+
+#endif //EDSP_MFCC_HPP
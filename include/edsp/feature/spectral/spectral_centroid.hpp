@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_CENTROID_HPP
 
 #include <edsp/feature/statistics/centroid.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -51,6 +52,17 @@ namespace edsp { namespace feature { inline namespace spectral {
         return statistics::weighted_centroid(first, last, first2);
     }
 
+    /**
+     * @brief Computes the spectral centroid of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @param first Forward iterator defining the begin of the center frequencies range.
+     * @return Estimated spectral centroid.
+     */
+    template <typename T, typename ForwardIt, typename = enable_if_split_value_t<T>>
+    auto spectral_centroid(const split_complex_view<T>& spectrum, ForwardIt first) {
+        return statistics::weighted_centroid(spectrum.magnitude_begin(), spectrum.magnitude_end(), first);
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_CENTROID_HPP
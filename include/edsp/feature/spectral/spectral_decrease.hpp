@@ -29,6 +29,7 @@
 
 #include <edsp/meta/expects.hpp>
 #include <edsp/feature/statistics/decrease.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -51,6 +52,16 @@ namespace edsp { namespace feature { inline namespace spectral {
         return statistics::decrease(first, last);
     }
 
+    /**
+     * @brief Computes the spectral decrease of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @return Estimated spectral decrease.
+     */
+    template <typename T, typename = enable_if_split_value_t<T>>
+    auto spectral_decrease(const split_complex_view<T>& spectrum) {
+        return spectral_decrease(spectrum.magnitude_begin(), spectrum.magnitude_end());
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_DECREASE_HPP
@@ -30,6 +30,7 @@
 #include <edsp/feature/statistics/entropy.hpp>
 #include <functional>
 #include <algorithm>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -65,5 +66,15 @@ namespace edsp { namespace feature { inline namespace spectral {
         return -acc / std::log2(size);
     }
 
+    /**
+     * @brief Computes the spectral entropy of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @return Estimated spectral entropy.
+     */
+    template <typename T, typename = enable_if_split_value_t<T>>
+    auto spectral_entropy(const split_complex_view<T>& spectrum) {
+        return spectral_entropy(spectrum.magnitude_begin(), spectrum.magnitude_end());
+    }
+
 }}}    // namespace edsp::feature::spectral
 #endif //EDSP_SPECTRAL_ENTROPY_HPP
@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_FLATNESS_HPP
 
 #include <edsp/feature/statistics/flatness.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -46,6 +47,16 @@ namespace edsp { namespace feature { inline namespace spectral {
         return statistics::flatness(first, last);
     }
 
+    /**
+     * @brief Computes the spectral flatness of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @return Estimated spectral flatness.
+     */
+    template <typename T, typename = enable_if_split_value_t<T>>
+    auto spectral_flatness(const split_complex_view<T>& spectrum) {
+        return spectral_flatness(spectrum.magnitude_begin(), spectrum.magnitude_end());
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_FLATNESS_HPP
@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_FLUX_HPP
 
 #include <edsp/feature/statistics/flux.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -44,6 +45,17 @@ namespace edsp { namespace feature { inline namespace spectral {
         return statistics::flux<distances::euclidean>(first1, last1, first2);
     }
 
+    /**
+     * @brief Computes the spectral flux between the magnitude spectra of two split-complex spectra of the same size.
+     * @param spectrum1 View of the first split-complex spectrum.
+     * @param spectrum2 View of the second split-complex spectrum.
+     * @return The estimated flux.
+     */
+    template <typename T, typename = enable_if_split_value_t<T>>
+    auto spectral_flux(const split_complex_view<T>& spectrum1, const split_complex_view<T>& spectrum2) {
+        return spectral_flux(spectrum1.magnitude_begin(), spectrum1.magnitude_end(), spectrum2.magnitude_begin());
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_FLUX_HPP
@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_IRREGULARITY_HPP
 
 #include <iterator>
+#include <edsp/spectral/split_complex.hpp>
 namespace edsp { namespace feature { inline namespace spectral {
 
     /**
@@ -59,6 +60,16 @@ namespace edsp { namespace feature { inline namespace spectral {
         return square_diff / square_ampl;
     }
 
+    /**
+     * @brief Computes the spectral irregularity of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @return Estimated spectral irregularity.
+     */
+    template <typename T, typename = enable_if_split_value_t<T>>
+    auto spectral_irregularity(const split_complex_view<T>& spectrum) {
+        return spectral_irregularity(spectrum.magnitude_begin(), spectrum.magnitude_end());
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_IRREGULARITY_HPP
@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_KURTOSIS_HPP
 
 #include <edsp/statistics/kurtosis.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -43,6 +44,16 @@ namespace edsp { namespace feature { inline namespace spectral {
         return edsp::statistics::kurtosis(first, last);
     }
 
+    /**
+     * @brief Computes the spectral kurtosis of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @return Estimated spectral kurtosis.
+     */
+    template <typename T, typename = enable_if_split_value_t<T>>
+    auto spectral_kurtosis(const split_complex_view<T>& spectrum) {
+        return spectral_kurtosis(spectrum.magnitude_begin(), spectrum.magnitude_end());
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_KURTOSIS_HPP
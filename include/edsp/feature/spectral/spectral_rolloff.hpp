@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_ROLLOFF_HPP
 
 #include <edsp/feature/statistics/rolloff.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -48,6 +49,18 @@ namespace edsp { namespace feature { inline namespace spectral {
         return statistics::rolloff(first, last, percentage);
     }
 
+    /**
+     * @brief Computes the spectral roll-off of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @param percentage Number between [0, 1] representing the percentage of the total energy of the roll-off
+     * frequency.
+     * @return Estimated roll-off index.
+     */
+    template <typename T, typename Numeric, typename = enable_if_split_value_t<T>>
+    auto spectral_rolloff(const split_complex_view<T>& spectrum, Numeric percentage = 0.95) {
+        return spectral_rolloff(spectrum.magnitude_begin(), spectrum.magnitude_end(), percentage);
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_ROLLOFF_HPP
@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_SKWNESS_HPP
 
 #include <edsp/statistics/skewness.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -43,6 +44,16 @@ namespace edsp { namespace feature { inline namespace spectral {
         return edsp::statistics::skewness(first, last);
     }
 
+    /**
+     * @brief Computes the spectral skewness of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @return Estimated spectral skewness.
+     */
+    template <typename T, typename = enable_if_split_value_t<T>>
+    auto spectral_skewness(const split_complex_view<T>& spectrum) {
+        return spectral_skewness(spectrum.magnitude_begin(), spectrum.magnitude_end());
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_SKWNESS_HPP
@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_SLOPE_HPP
 
 #include <edsp/feature/statistics/slope.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -63,6 +64,17 @@ namespace edsp { namespace feature { inline namespace spectral {
         return statistics::slope(first1, last1, first2);
     }
 
+    /**
+     * @brief Computes the spectral slope of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @param first Forward iterator defining the begin of the center frequencies range.
+     * @return Estimated spectral slope.
+     */
+    template <typename T, typename ForwardIt, typename = enable_if_split_value_t<T>>
+    auto spectral_slope(const split_complex_view<T>& spectrum, ForwardIt first) {
+        return statistics::slope(spectrum.magnitude_begin(), spectrum.magnitude_end(), first);
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_SLOPE_HPP
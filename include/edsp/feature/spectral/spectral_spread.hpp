@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_SPREAD_HPP
 
 #include <edsp/feature/statistics/spread.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -55,6 +56,17 @@ namespace edsp { namespace feature { inline namespace spectral {
         return statistics::weighted_spread(first1, last1, first2);
     }
 
+    /**
+     * @brief Computes the spectral spread of the magnitude spectrum of a split-complex spectrum.
+     * @param spectrum View of the split-complex spectrum.
+     * @param first Forward iterator defining the begin of the center frequencies range.
+     * @return Estimated spectral spread.
+     */
+    template <typename T, typename ForwardIt, typename = enable_if_split_value_t<T>>
+    auto spectral_spread(const split_complex_view<T>& spectrum, ForwardIt first) {
+        return statistics::weighted_spread(spectrum.magnitude_begin(), spectrum.magnitude_end(), first);
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_SPREAD_HPP
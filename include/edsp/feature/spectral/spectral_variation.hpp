@@ -28,6 +28,7 @@
 #define EDSP_SPECTRAL_VARIATION_HPP
 
 #include <edsp/feature/statistics/variation.hpp>
+#include <edsp/spectral/split_complex.hpp>
 
 namespace edsp { namespace feature { inline namespace spectral {
 
@@ -58,6 +59,18 @@ namespace edsp { namespace feature { inline namespace spectral {
         return statistics::variation(first1, last1, first2);
     }
 
+    /**
+     * @brief Computes the spectral variation between the magnitude spectra of two split-complex spectra of the same
+     * size.
+     * @param spectrum1 View of the first split-complex spectrum.
+     * @param spectrum2 View of the second split-complex spectrum.
+     * @return The estimated spectral variation.
+     */
+    template <typename T, typename = enable_if_split_value_t<T>>
+    auto spectral_variation(const split_complex_view<T>& spectrum1, const split_complex_view<T>& spectrum2) {
+        return spectral_variation(spectrum1.magnitude_begin(), spectrum1.magnitude_end(), spectrum2.magnitude_begin());
+    }
+
 }}} // namespace edsp::feature::spectral
 
 #endif //EDSP_SPECTRAL_VARIATION_HPP
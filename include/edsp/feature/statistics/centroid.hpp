@@ -65,8 +65,8 @@ namespace edsp { namespace feature { inline namespace statistics {
      * @returns The centroid value of the input range.
      * @see mean
      */
-    template <typename ForwardIt>
-    constexpr meta::value_type_t<ForwardIt> weighted_centroid(ForwardIt first1, ForwardIt last1, ForwardIt first2) {
+    template <typename ForwardIt, typename ForwardIt2 = ForwardIt>
+    constexpr meta::value_type_t<ForwardIt> weighted_centroid(ForwardIt first1, ForwardIt last1, ForwardIt2 first2) {
         using input_t       = meta::value_type_t<ForwardIt>;
         auto weighted_sum   = static_cast<input_t>(0);
         auto unweighted_sum = static_cast<input_t>(0);
@@ -58,8 +58,8 @@ namespace edsp { namespace feature { inline namespace statistics {
      * @param first2 Forward iterator defining the begin of the center frequencies range.
      * @return Estimated slope coefficient.
      */
-    template <typename ForwardIt>
-    constexpr auto slope(ForwardIt first1, ForwardIt last1, ForwardIt first2) {
+    template <typename ForwardIt, typename ForwardIt2 = ForwardIt>
+    constexpr auto slope(ForwardIt first1, ForwardIt last1, ForwardIt2 first2) {
         using value_type = typename std::iterator_traits<ForwardIt>::value_type;
         auto m_sum       = static_cast<value_type>(0);
         auto f_sum       = static_cast<value_type>(0);
@@ -69,8 +69,8 @@ namespace edsp { namespace feature { inline namespace statistics {
      * @param first2 Forward iterator defining the beginning of the range representing the weights, \f$f(i)\f$.
      * @returns The spread value of the input range.
      */
-    template <typename ForwardIt>
-    constexpr meta::value_type_t<ForwardIt> weighted_spread(ForwardIt first1, ForwardIt last1, ForwardIt first2) {
+    template <typename ForwardIt, typename ForwardIt2 = ForwardIt>
+    constexpr meta::value_type_t<ForwardIt> weighted_spread(ForwardIt first1, ForwardIt last1, ForwardIt2 first2) {
         using value_type    = typename std::iterator_traits<ForwardIt>::value_type;
         const auto centroid = statistics::weighted_centroid(first1, last1, first2);
         auto weighted_sum   = static_cast<value_type>(0);
@@ -24,9 +24,16 @@
 
 #include <edsp/filter/biquad.hpp>
 #include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/filter/biquad_parallel.hpp>
+#include <edsp/filter/filtfilt.hpp>
+#include <edsp/filter/modulated_biquad.hpp>
 #include <edsp/filter/moving_median_filter.hpp>
+#include <edsp/filter/moving_quantile_filter.hpp>
 #include <edsp/filter/moving_average_filter.hpp>
 #include <edsp/filter/moving_rms_filter.hpp>
+#include <edsp/filter/hilbert_filter.hpp>
+#include <edsp/filter/multichannel_biquad.hpp>
+#include <edsp/filter/multichannel_biquad_cascade.hpp>
 
 #include <edsp/filter/internal/rbj_designer.hpp>
 #include <edsp/filter/internal/zoelzer_designer.hpp>
@@ -113,6 +120,12 @@ namespace edsp { namespace filter {
         constexpr auto design(Args... arg) const -> decltype(butterworth_designer<T, Type, MaxOrder>{}(arg...)) {
             return butterworth_designer<T, Type, MaxOrder>{}.operator()(arg...);
         }
+
+        template <filter_type Type, typename... Args>
+        constexpr auto design_parallel(Args... arg) const
+            -> decltype(butterworth_designer<T, Type, MaxOrder>{}.parallel(std::declval<Args&&>()...)) {
+            return butterworth_designer<T, Type, MaxOrder>{}.parallel(arg...);
+        }
     };
 
     /**
@@ -127,6 +140,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevI_designer<T, Type, MaxOrder>{}(std::declval<Args&&>()...)) {
             return chebyshevI_designer<T, Type, MaxOrder>{}(arg...);
         }
+
+        template <filter_type Type, typename... Args>
+        constexpr auto design_parallel(Args... arg) const
+            -> decltype(chebyshevI_designer<T, Type, MaxOrder>{}.parallel(std::declval<Args&&>()...)) {
+            return chebyshevI_designer<T, Type, MaxOrder>{}.parallel(arg...);
+        }
     };
 
     /**
@@ -141,6 +160,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevII_designer<T, Type, MaxOrder>{}(std::declval<Args&&>()...)) {
             return chebyshevII_designer<T, Type, MaxOrder>{}(arg...);
         }
+
+        template <filter_type Type, typename... Args>
+        constexpr auto design_parallel(Args... arg) const
+            -> decltype(chebyshevII_designer<T, Type, MaxOrder>{}.parallel(std::declval<Args&&>()...)) {
+            return chebyshevII_designer<T, Type, MaxOrder>{}.parallel(arg...);
+        }
     };
 
     /**
@@ -156,6 +181,23 @@ namespace edsp { namespace filter {
         return designer<T, Designer, MaxOrder>{}.template design<Type>(arg...);
     }
 
+    /**
+     * @brief Creates the parallel realization of a filter using args as the parameter list for the construction.
+     *
+     * The poles and zeros are the ones designed by make_filter, expanded in partial fractions into a %biquad_parallel.
+     * Only the designers based on the bilinear transform (Butterworth, ChebyshevI and ChebyshevII) are supported.
+     * @tparam T Value type
+     * @tparam Type Types of filter to be created.
+     * @param arg Arguments parameters to constructs the filter.
+     * @return A %biquad_parallel with the given configuration.
+     * @see make_filter, make_parallel
+     */
+    template <typename T, designer_type Designer, filter_type Type, std::size_t MaxOrder, typename... Args>
+    constexpr auto make_parallel_filter(Args... arg)
+        -> decltype(designer<T, Designer, MaxOrder>{}.template design_parallel<Type>(std::declval<Args&&>()...)) {
+        return designer<T, Designer, MaxOrder>{}.template design_parallel<Type>(arg...);
+    }
+
     /**
      * @brief Computes the frequency response of a digital filter.
      * @param b_first Beginning of the range elements representing the FIR/MA filter coefficients.
@@ -317,9 +317,19 @@ namespace edsp { namespace filter {
     template <typename T>
     template <typename InputIt, typename OutputIt>
     constexpr void biquad<T>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        // The coefficients and the state are copied into locals, so they stay in registers during the whole block
+        // instead of being reloaded after every store through d_first.
+        const auto b0 = b0_, b1 = b1_, b2 = b2_, a1 = a1_, a2 = a2_;
+        auto w0 = w0_, w1 = w1_;
         for (; first != last; ++first, ++d_first) {
-            *d_first = tick(*first);
+            const auto value = static_cast<value_type>(*first);
+            const auto out   = b0 * value + w0;
+            w0               = b1 * value - a1 * out + w1;
+            w1               = b2 * value - a2 * out;
+            *d_first         = out;
         }
+        w0_ = w0;
+        w1_ = w1;
     }
 
     template <typename T>
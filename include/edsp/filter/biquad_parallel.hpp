@@ -0,0 +1,417 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: biquad_parallel.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_BIQUAD_PARALLEL_HPP
+#define EDSP_BIQUAD_PARALLEL_HPP
+
+#include <edsp/filter/biquad.hpp>
+#include <edsp/filter/internal/bilinear/layout_base.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/ensure.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <limits>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @brief The biquad_parallel class implements an IIR filter as a sum of second order sections.
+     *
+     * Every section filters the same input and the output of the filter is the sum of the outputs of all the
+     * sections:
+     *
+     * \f[
+     *  H(z) = \sum_{k=0}^{K-1} \frac{b_{0,k} + b_{1,k}z^{-1} + b_{2,k}z^{-2}}{1 + a_{1,k}z^{-1} + a_{2,k}z^{-2}}
+     * \f]
+     *
+     * Unlike the %biquad_cascade, where the output of every section feeds the next one, the sections do not depend
+     * on each other. The latency of every sample is the one of a single section, whatever the order of the filter,
+     * and the sections are mapped to SIMD lanes. The coefficients and the states are stored in separate arrays of N
+     * elements; the unused sections have null coefficients.
+     *
+     * Every section uses the Transposed Direct Form II of the %biquad class.
+     *
+     * @tparam T Value type.
+     * @tparam N Number representing the maximum size (number of sections).
+     * @see make_parallel, biquad_cascade
+     */
+    template <typename T, std::size_t N>
+    class biquad_parallel {
+    public:
+        using value_type = biquad<T>;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Creates an empty %biquad_parallel
+         */
+        biquad_parallel() noexcept;
+
+        /**
+         * @brief Returns the number of sections.
+         * @return Number of sections.
+         */
+        constexpr size_type size() const noexcept;
+
+        /**
+         * @brief Returns the maximum number of sections the filter is able to hold.
+         * @return Maximum number of elements.
+         * @see N
+         */
+        constexpr size_type max_size() const noexcept;
+
+        /**
+         * @brief Returns the capacity the filter.
+         * @return Capacity of the currently allocated storage.
+         * @see max_size
+         */
+        constexpr size_type capacity() const noexcept;
+
+        /**
+         * @brief Removes all the sections.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Reset all the sections to the original state.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Returns a Biquad with the coefficients of the section at specified location pos. No bounds checking
+         * is performed.
+         * @param index Position of the section.
+         * @return Biquad with the coefficients of the section.
+         */
+        value_type operator[](size_type index) const noexcept;
+
+        /**
+         * @brief Appends a section with the coefficients of the given Biquad at the end.
+         * @param biquad Biquad to append.
+         */
+        void push_back(const biquad<T>& biquad);
+
+        /**
+         * @brief Construct a Biquad in-place at the end.
+         * @param arg Arguments to forward to the constructor of the element
+         */
+        template <typename... Arg>
+        void emplace_back(Arg... arg);
+
+        /**
+         * @brief Filters the signal in the range [first, last) and stores the result in another range, beginning at
+         * d_first.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Computes the output of filtering one digital time-step.
+         * @param value Input value to be filtered.
+         * @return Filtered value.
+         */
+        T tick(T value) noexcept;
+
+    private:
+        using lanes = std::array<T, N>;
+
+        size_type num_stage_{0};
+        lanes b0_{};
+        lanes b1_{};
+        lanes b2_{};
+        lanes a1_{};
+        lanes a2_{};
+        lanes w0_{};
+        lanes w1_{};
+    };
+
+    template <typename T, std::size_t N>
+    biquad_parallel<T, N>::biquad_parallel() noexcept {
+        clear();
+    }
+
+    template <typename T, std::size_t N>
+    constexpr typename biquad_parallel<T, N>::size_type biquad_parallel<T, N>::size() const noexcept {
+        return num_stage_;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr typename biquad_parallel<T, N>::size_type biquad_parallel<T, N>::max_size() const noexcept {
+        return N;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr typename biquad_parallel<T, N>::size_type biquad_parallel<T, N>::capacity() const noexcept {
+        return N;
+    }
+
+    template <typename T, std::size_t N>
+    void biquad_parallel<T, N>::clear() noexcept {
+        num_stage_ = 0;
+        b0_.fill(0);
+        b1_.fill(0);
+        b2_.fill(0);
+        a1_.fill(0);
+        a2_.fill(0);
+        reset();
+    }
+
+    template <typename T, std::size_t N>
+    void biquad_parallel<T, N>::reset() noexcept {
+        w0_.fill(0);
+        w1_.fill(0);
+    }
+
+    template <typename T, std::size_t N>
+    typename biquad_parallel<T, N>::value_type biquad_parallel<T, N>::operator[](size_type index) const noexcept {
+        return value_type(1, a1_[index], a2_[index], b0_[index], b1_[index], b2_[index]);
+    }
+
+    template <typename T, std::size_t N>
+    void biquad_parallel<T, N>::push_back(const biquad<T>& biquad) {
+        meta::ensure(num_stage_ < N, "No space available");
+        b0_[num_stage_] = biquad.b0();
+        b1_[num_stage_] = biquad.b1();
+        b2_[num_stage_] = biquad.b2();
+        a1_[num_stage_] = biquad.a1();
+        a2_[num_stage_] = biquad.a2();
+        w0_[num_stage_] = 0;
+        w1_[num_stage_] = 0;
+        num_stage_++;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename... Arg>
+    void biquad_parallel<T, N>::emplace_back(Arg... arg) {
+        push_back(biquad<T>(arg...));
+    }
+
+    template <typename T, std::size_t N>
+    T biquad_parallel<T, N>::tick(T value) noexcept {
+        T out = 0;
+        filter(&value, &value + 1, &out);
+        return out;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename InputIt, typename OutputIt>
+    void biquad_parallel<T, N>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        // Local copies can not alias the input or the output, so they stay in registers during the whole range. Every
+        // equation is a separate loop over the sections, which the compiler turns into a few SIMD operations. The sum
+        // does not feed the next time-step, so it does not lengthen the dependency chain.
+        const auto b0 = b0_, b1 = b1_, b2 = b2_, a1 = a1_, a2 = a2_;
+        auto w0 = w0_, w1 = w1_;
+        for (; first != last; ++first, ++d_first) {
+            const T value = *first;
+            lanes out;
+            for (size_type k = 0; k < N; ++k) {
+                out[k] = b0[k] * value + w0[k];
+            }
+            for (size_type k = 0; k < N; ++k) {
+                w0[k] = b1[k] * value - a1[k] * out[k] + w1[k];
+            }
+            for (size_type k = 0; k < N; ++k) {
+                w1[k] = b2[k] * value - a2[k] * out[k];
+            }
+            T sum = 0;
+            for (size_type k = 0; k < N; ++k) {
+                sum += out[k];
+            }
+            *d_first = sum;
+        }
+        w0_ = w0;
+        w1_ = w1;
+    }
+
+    namespace internal {
+
+        // Multiplies the truncated series at z = 0 by the factor (z - root), up to the given degree.
+        template <typename T, std::size_t Size>
+        void truncated_product(std::array<std::complex<T>, Size>& series, std::size_t degree,
+                               const std::complex<T>& root) noexcept {
+            for (auto k = degree; k > 0; --k) {
+                series[k] = series[k - 1] - root * series[k];
+            }
+            series[0] = -root * series[0];
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Converts the poles and zeros of a digital layout into a %biquad_parallel.
+     *
+     * The transfer function is expanded in partial fractions, one per pole:
+     *
+     * \f[
+     *  H(z) = g\frac{\prod_{j}(1 - z_j z^{-1})}{\prod_{i}(1 - p_i z^{-1})}
+     *       = \sum_{i} \frac{r_i}{1 - p_i z^{-1}} + \sum_{k=0}^{d} c_k z^{-k}
+     * \f]
+     *
+     * The residues are evaluated from the poles and the zeros, without expanding the polynomials, so the
+     * conversion stays accurate for high orders. The fractions of two conjugate poles are merged into a second order
+     * section with real coefficients, and so are the fractions of two real poles. The polynomial part, a constant
+     * unless some poles lie at the origin, is merged into one of the sections when possible, so the realization
+     * has as many sections as the %biquad_cascade designed from the same layout.
+     *
+     * The gain g is chosen so that the magnitude response at the normalization frequency of the layout is its gain,
+     * as done for the serial realization. The poles must be distinct.
+     *
+     * @param digital Digital layout generated by one of the designers.
+     * @return Parallel realization of the layout.
+     * @see biquad_parallel
+     */
+    template <typename T, std::size_t N>
+    biquad_parallel<T, (N + 1) / 2> make_parallel(const LayoutBase<T, N>& digital) {
+        using complex_type = std::complex<T>;
+        constexpr std::size_t max_roots = 2 * ((N + 1) / 2);
+
+        // Collects the roots of the layout. Poles at the origin do not contribute any fraction.
+        std::array<complex_type, max_roots> poles{};
+        std::array<complex_type, max_roots> zeros{};
+        std::size_t num_poles = 0, num_zeros = 0, num_origin = 0;
+        const auto tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+        const auto append    = [&](const complex_type& pole, const complex_type& zero) {
+            if (std::abs(pole) > tolerance) {
+                poles[num_poles++] = pole;
+            } else {
+                num_origin++;
+            }
+            zeros[num_zeros++] = zero;
+        };
+        for (std::size_t i = 0, size = (digital.poles() + 1) / 2; i < size; ++i) {
+            const auto& pair = digital[i];
+            append(pair.poles().first, pair.zeros().first);
+            if (!pair.single_pole()) {
+                append(pair.poles().second, pair.zeros().second);
+            }
+        }
+
+        // Gain of the normalized response, with the polynomials in the factored form.
+        const auto czn1 = std::polar(static_cast<T>(1), -digital.w());
+        auto response   = complex_type(1, 0);
+        for (std::size_t i = 0; i < num_zeros; ++i) {
+            response *= complex_type(1, 0) - zeros[i] * czn1;
+        }
+        for (std::size_t i = 0; i < num_poles; ++i) {
+            response /= complex_type(1, 0) - poles[i] * czn1;
+        }
+        const auto gain = digital.gain() / std::abs(response);
+
+        // The numerator and the denominator factors are interleaved to keep the partial products in range.
+        const auto residue = [&](std::size_t index) {
+            const auto& pole = poles[index];
+            auto value       = complex_type(gain, 0);
+            for (std::size_t i = 0, size = std::max(num_zeros, num_poles); i < size; ++i) {
+                if (i < num_zeros) {
+                    value *= complex_type(1, 0) - zeros[i] / pole;
+                }
+                if (i < num_poles && i != index) {
+                    value /= complex_type(1, 0) - poles[i] / pole;
+                }
+            }
+            return value;
+        };
+
+        // Polynomial part: c_k is the coefficient of z^(d - k) in the Taylor series at the origin of
+        // g * prod(z - z_j) / prod(z - p_i).
+        const auto degree = num_origin;
+        meta::expects(degree <= 2, "Too many poles at the origin");
+        std::array<complex_type, 3> numerator{};
+        std::array<complex_type, 3> denominator{};
+        numerator[0]   = complex_type(gain, 0);
+        denominator[0] = complex_type(1, 0);
+        for (std::size_t i = 0, size = std::max(num_zeros, num_poles); i < size; ++i) {
+            if (i < num_zeros) {
+                internal::truncated_product(numerator, degree, zeros[i]);
+            }
+            if (i < num_poles) {
+                // The factor (z - p) is scaled by -1/p, so that the constant term of the denominator is one.
+                for (std::size_t k = 0; k <= degree; ++k) {
+                    numerator[k] /= -poles[i];
+                }
+                internal::truncated_product(denominator, degree, poles[i]);
+                for (std::size_t k = 0; k <= degree; ++k) {
+                    denominator[k] /= -poles[i];
+                }
+            }
+        }
+        std::array<T, 3> direct{};
+        std::array<complex_type, 3> series{};
+        for (std::size_t k = 0; k <= degree; ++k) {
+            series[k] = numerator[k];
+            for (std::size_t i = 1; i <= k; ++i) {
+                series[k] -= denominator[i] * series[k - i];
+            }
+            direct[degree - k] = series[k].real();
+        }
+
+        std::array<biquad<T>, (N + 1) / 2> sections{};
+        std::size_t num_sections = 0;
+        std::size_t pending      = num_poles;
+        for (std::size_t i = 0; i < num_poles; ++i) {
+            const auto& pole = poles[i];
+            if (pole.imag() > 0) {
+                const auto r             = residue(i);
+                sections[num_sections++] = biquad<T>(1, -2 * pole.real(), std::norm(pole), 2 * r.real(),
+                                                     -2 * (r * std::conj(pole)).real(), 0);
+            } else if (pole.imag() == 0) {
+                if (pending == num_poles) {
+                    pending = i;
+                } else {
+                    const auto p1 = pole.real(), p2 = poles[pending].real();
+                    const auto r1 = residue(i).real(), r2 = residue(pending).real();
+                    sections[num_sections++] = biquad<T>(1, -(p1 + p2), p1 * p2, r1 + r2, -(r1 * p2 + r2 * p1), 0);
+                    pending                  = num_poles;
+                }
+            }
+        }
+        if (pending != num_poles) {
+            sections[num_sections++] = biquad<T>(1, -poles[pending].real(), 0, residue(pending).real(), 0, 0);
+        }
+
+        // The polynomial c(z) is written as c(z) A(z) / A(z) and merged into a section whose numerator stays of second
+        // order: any section for a constant, the first order one for a polynomial of first degree. Otherwise, there
+        // are enough poles at the origin to leave room for an extra FIR section.
+        const auto single = (pending != num_poles);
+        if ((degree == 0 && num_sections > 0) || (degree == 1 && single)) {
+            auto& section = sections[(degree == 0) ? 0 : num_sections - 1];
+            section       = biquad<T>(1, section.a1(), section.a2(), section.b0() + direct[0],
+                                section.b1() + direct[1] + direct[0] * section.a1(),
+                                section.b2() + direct[1] * section.a1() + direct[0] * section.a2());
+        } else {
+            sections[num_sections++] = biquad<T>(1, 0, 0, direct[0], direct[1], direct[2]);
+        }
+
+        biquad_parallel<T, (N + 1) / 2> parallel;
+        for (std::size_t i = 0; i < num_sections; ++i) {
+            parallel.push_back(sections[i]);
+        }
+        return parallel;
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_BIQUAD_PARALLEL_HPP
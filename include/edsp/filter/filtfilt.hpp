@@ -0,0 +1,253 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: filtfilt.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_FILTER_FILTFILT_HPP
+#define EDSP_FILTER_FILTFILT_HPP
+
+#include <edsp/filter/biquad.hpp>
+#include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/iterator.hpp>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    inline namespace internal {
+
+        /**
+         * @brief Filters with a cascade of at most N Biquad sections, using the Transposed Direct Form II.
+         */
+        template <typename T, std::size_t N>
+        class sections_kernel {
+        public:
+            template <typename SectionIt>
+            sections_kernel(SectionIt first, SectionIt last) {
+                for (; first != last; ++first, ++size_) {
+                    b0_[size_] = first->b0();
+                    b1_[size_] = first->b1();
+                    b2_[size_] = first->b2();
+                    a1_[size_] = first->a1();
+                    a2_[size_] = first->a2();
+                }
+            }
+
+            // Padding used by scipy.signal.sosfiltfilt.
+            std::size_t padding() const noexcept {
+                std::size_t b2 = 0, a2 = 0;
+                for (std::size_t i = 0; i < size_; ++i) {
+                    b2 += (b2_[i] == 0) ? 1 : 0;
+                    a2 += (a2_[i] == 0) ? 1 : 0;
+                }
+                return 3 * (2 * size_ + 1 - std::min(b2, a2));
+            }
+
+            // Sets the steady state of every section for a constant input of the cascade.
+            void initialize(T level) noexcept {
+                for (std::size_t i = 0; i < size_; ++i) {
+                    const auto output = level * (b0_[i] + b1_[i] + b2_[i]) / (1 + a1_[i] + a2_[i]);
+                    w1_[i]            = b2_[i] * level - a2_[i] * output;
+                    w0_[i]            = b1_[i] * level - a1_[i] * output + w1_[i];
+                    level             = output;
+                }
+            }
+
+            template <typename Iterator>
+            void filter(Iterator first, Iterator last) noexcept {
+                for (; first != last; ++first) {
+                    auto value = static_cast<T>(*first);
+                    for (std::size_t i = 0; i < size_; ++i) {
+                        const auto out = b0_[i] * value + w0_[i];
+                        w0_[i]         = b1_[i] * value - a1_[i] * out + w1_[i];
+                        w1_[i]         = b2_[i] * value - a2_[i] * out;
+                        value          = out;
+                    }
+                    *first = value;
+                }
+            }
+
+        private:
+            std::array<T, N> b0_{};
+            std::array<T, N> b1_{};
+            std::array<T, N> b2_{};
+            std::array<T, N> a1_{};
+            std::array<T, N> a2_{};
+            std::array<T, N> w0_{};
+            std::array<T, N> w1_{};
+            std::size_t size_{0};
+        };
+
+        /**
+         * @brief Filters with a FIR filter using the Transposed Direct Form II.
+         */
+        template <typename T>
+        class fir_kernel {
+        public:
+            template <typename InputIt>
+            fir_kernel(InputIt first, InputIt last) : taps_(first, last), state_(taps_.size(), 0) {}
+
+            // Padding used by scipy.signal.filtfilt.
+            std::size_t padding() const noexcept {
+                return 3 * taps_.size();
+            }
+
+            // Sets the steady state of the filter for a constant input.
+            void initialize(T level) noexcept {
+                T sum = 0;
+                for (auto i = taps_.size(); i > 0; --i) {
+                    state_[i - 1] = sum * level;
+                    sum += taps_[i - 1];
+                }
+            }
+
+            template <typename Iterator>
+            void filter(Iterator first, Iterator last) noexcept {
+                // The last element of the state is always zero, so the inner loop does not need a special case.
+                const auto order = taps_.size() - 1;
+                for (; first != last; ++first) {
+                    const auto value = static_cast<T>(*first);
+                    const auto out   = taps_[0] * value + state_[0];
+                    for (std::size_t i = 0; i < order; ++i) {
+                        state_[i] = taps_[i + 1] * value + state_[i + 1];
+                    }
+                    *first = out;
+                }
+            }
+
+        private:
+            std::vector<T> taps_;
+            std::vector<T> state_;
+        };
+
+        /**
+         * @brief Applies the kernel forward and backward over the range [first, last), in place.
+         *
+         * The signal is extended at both ends with an odd extension of the given number of samples, stored in the
+         * left and right buffers, and every pass starts from the steady state of the first extended sample.
+         */
+        template <typename T, typename Kernel, typename BiIterator, typename PadIt>
+        void forward_backward(Kernel& kernel, BiIterator first, BiIterator last, PadIt left, PadIt right,
+                              std::size_t padding) {
+            const auto size = static_cast<std::size_t>(std::distance(first, last));
+            if (size == 0) {
+                return;
+            }
+
+            padding               = std::min(padding, size - 1);
+            const auto length     = static_cast<std::ptrdiff_t>(padding);
+            const auto left_last  = left + length;
+            const auto right_last = right + length;
+            const auto front      = static_cast<T>(*first);
+            const auto back       = static_cast<T>(*std::prev(last));
+            auto it               = std::next(first, length);
+            for (auto out = left; out != left_last; ++out, --it) {
+                *out = 2 * front - static_cast<T>(*it);
+            }
+            it = std::prev(last);
+            for (auto out = right; out != right_last; ++out) {
+                *out = 2 * back - static_cast<T>(*--it);
+            }
+
+            // Only the end of the forward output is needed by the backward pass, so the left extension is not filtered
+            // backwards.
+            kernel.initialize((padding > 0) ? *left : front);
+            kernel.filter(left, left_last);
+            kernel.filter(first, last);
+            kernel.filter(right, right_last);
+
+            kernel.initialize((padding > 0) ? *std::prev(right_last) : static_cast<T>(*std::prev(last)));
+            kernel.filter(std::make_reverse_iterator(right_last), std::make_reverse_iterator(right));
+            kernel.filter(std::make_reverse_iterator(last), std::make_reverse_iterator(first));
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Applies a Biquad filter forward and backward over the signal in the range [first, last), in place.
+     *
+     * The result has zero phase and the squared magnitude response of the filter. As in scipy.signal.sosfiltfilt,
+     * the signal is extended at both ends with an odd extension of 9 samples (6 for a first order section), or the
+     * size of the signal minus one if it is shorter, and every pass starts from the steady state of the filter for
+     * its first sample (Gustafsson's lfilter_zi initial conditions), which removes the transients at the edges. The
+     * extensions are stored in small fixed buffers: the signal is not copied.
+     *
+     * @param filter Biquad filter to be applied. Its state is not used nor modified.
+     * @param first Bidirectional iterator defining the beginning of the range to be filtered.
+     * @param last Bidirectional iterator defining the ending of the range to be filtered.
+     */
+    template <typename T, typename BiIterator>
+    void filtfilt(const biquad<T>& filter, BiIterator first, BiIterator last) {
+        internal::sections_kernel<T, 1> kernel(&filter, &filter + 1);
+        std::array<T, 9> left, right;
+        internal::forward_backward<T>(kernel, first, last, std::begin(left), std::begin(right), kernel.padding());
+    }
+
+    /**
+     * @brief Applies a cascade of Biquad filters forward and backward over the signal in the range [first, last), in
+     * place.
+     *
+     * The result has zero phase and the squared magnitude response of the cascade. As in scipy.signal.sosfiltfilt,
+     * the signal is extended at both ends with an odd extension of 3 (2 n + 1) samples, n being the number of
+     * second order sections, or the size of the signal minus one if it is shorter, and every pass starts from the
+     * steady state of the cascade for its first sample (Gustafsson's lfilter_zi initial conditions), which removes
+     * the transients at the edges. The extensions are stored in small fixed buffers: the signal is not copied.
+     *
+     * @param cascade Cascade of Biquad filters to be applied. Its state is not used nor modified.
+     * @param first Bidirectional iterator defining the beginning of the range to be filtered.
+     * @param last Bidirectional iterator defining the ending of the range to be filtered.
+     */
+    template <typename T, std::size_t N, typename BiIterator>
+    void filtfilt(const biquad_cascade<T, N>& cascade, BiIterator first, BiIterator last) {
+        internal::sections_kernel<T, N> kernel(std::cbegin(cascade), std::cend(cascade));
+        std::array<T, 3 * (2 * N + 1)> left, right;
+        internal::forward_backward<T>(kernel, first, last, std::begin(left), std::begin(right), kernel.padding());
+    }
+
+    /**
+     * @brief Applies a FIR filter forward and backward over the signal in the range [first, last), in place.
+     *
+     * The result has zero phase and the squared magnitude response of the filter. As in scipy.signal.filtfilt, the
+     * signal is extended at both ends with an odd extension of three times the number of taps, or the size of the
+     * signal minus one if it is shorter, and every pass starts from the steady state of the filter for its first
+     * sample (lfilter_zi initial conditions). Only the taps, the state and the extensions are allocated: the signal
+     * is not copied.
+     *
+     * @param b_first Forward iterator defining the beginning of the range of taps.
+     * @param b_last Forward iterator defining the ending of the range of taps.
+     * @param first Bidirectional iterator defining the beginning of the range to be filtered.
+     * @param last Bidirectional iterator defining the ending of the range to be filtered.
+     */
+    template <typename ForwardIt, typename BiIterator>
+    void filtfilt(ForwardIt b_first, ForwardIt b_last, BiIterator first, BiIterator last) {
+        using value_type = meta::value_type_t<ForwardIt>;
+        meta::expects(std::distance(b_first, b_last) > 0, "Not expecting an empty filter");
+        internal::fir_kernel<value_type> kernel(b_first, b_last);
+        std::vector<value_type> left(kernel.padding()), right(kernel.padding());
+        internal::forward_backward<value_type>(kernel, first, last, std::begin(left), std::begin(right),
+                                               kernel.padding());
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_FILTFILT_HPP
@@ -0,0 +1,168 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: hilbert_filter.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_FILTER_HILBERT_FILTER_H
+#define EDSP_FILTER_HILBERT_FILTER_H
+
+#include <edsp/windowing/blackman.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <complex>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class hilbert_filter
+     * @brief This class implements a streaming Hilbert transformer, a linear-phase FIR filter of odd length N
+     * approximating the ideal Hilbert transform, suitable to compute the analytic signal block by block.
+     *
+     * The impulse response of the ideal Hilbert transform is truncated and weighted by a Blackman window of N + 2
+     * samples, whose null endpoints fall outside of the filter, so the outermost odd taps are never discarded:
+     *
+     * \f[
+     *  h(n) = \frac{2}{\pi n} w\left(n + \frac{N + 1}{2}\right) \quad \text{n odd}, \qquad h(n) = 0 \quad \text{n even}
+     * \f]
+     *
+     * As the even taps are null and the odd ones are antisymmetric, every output sample costs (N + 1) / 4
+     * multiplications. The real part of the output is the input delayed by delay() samples, to keep it aligned with
+     * the filtered imaginary part.
+     *
+     * @tparam T  Type of element.
+     * @tparam Allocator  Allocator type, defaults to std::allocator<T>.
+     * @see spectral::hilbert_transformer
+     */
+    template <typename T, typename Allocator = std::allocator<T>>
+    class hilbert_filter {
+    public:
+        using size_type    = std::size_t;
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+
+        /**
+         *  @brief Creates a %hilbert_filter with N taps.
+         *  @param N Number of taps of the filter, it should be odd and greater than one.
+         */
+        explicit hilbert_filter(size_type N);
+
+        /**
+         *  @brief Returns the number of taps of the filter.
+         */
+        size_type size() const;
+
+        /**
+         *  @brief Returns the delay, in samples, introduced by the filter.
+         */
+        size_type delay() const;
+
+        /**
+         * @brief Reset the filter to the original state.
+         */
+        void reset();
+
+        /**
+         * @brief Computes the analytic signal of the elements in the range [first, last) and stores the result
+         * in another range, beginning at d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the complex destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Computes the analytic signal of a single element.
+         * @return The delayed input as real part, and its Hilbert transform as imaginary part.
+         */
+        complex_type operator()(value_type tick);
+
+    private:
+        // Odd taps of the positive half of the impulse response: h(1), h(3), ...
+        std::vector<T, Allocator> coefficients_;
+        // The delay line is stored twice, so the last N samples are always contiguous.
+        std::vector<T, Allocator> history_;
+        size_type size_;
+        size_type head_{0};
+    };
+
+    template <typename T, typename Allocator>
+    hilbert_filter<T, Allocator>::hilbert_filter(size_type N) :
+        coefficients_((N + 1) / 4),
+        history_(2 * N, static_cast<T>(0)),
+        size_(N) {
+        meta::expects(N > 1 && N % 2 == 1, "The number of taps must be odd and greater than one");
+        std::vector<T, Allocator> window(N + 2);
+        windowing::blackman(std::begin(window), std::end(window));
+
+        const auto center = delay() + 1;
+        for (size_type i = 0; i < coefficients_.size(); ++i) {
+            const auto n     = 2 * i + 1;
+            coefficients_[i] = 2 / (constants<T>::pi * static_cast<T>(n)) * window[center + n];
+        }
+    }
+
+    template <typename T, typename Allocator>
+    typename hilbert_filter<T, Allocator>::size_type hilbert_filter<T, Allocator>::size() const {
+        return size_;
+    }
+
+    template <typename T, typename Allocator>
+    typename hilbert_filter<T, Allocator>::size_type hilbert_filter<T, Allocator>::delay() const {
+        return (size_ - 1) / 2;
+    }
+
+    template <typename T, typename Allocator>
+    void hilbert_filter<T, Allocator>::reset() {
+        std::fill(std::begin(history_), std::end(history_), static_cast<T>(0));
+        head_ = 0;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIt, typename OutputIt>
+    void hilbert_filter<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        std::transform(first, last, d_first, std::ref(*this));
+    }
+
+    template <typename T, typename Allocator>
+    typename hilbert_filter<T, Allocator>::complex_type hilbert_filter<T, Allocator>::operator()(value_type tick) {
+        history_[head_]         = tick;
+        history_[head_ + size_] = tick;
+        head_                   = (head_ + 1 == size_) ? 0 : head_ + 1;
+
+        // The window stores the last N samples, from the oldest to the newest one.
+        const auto* window = history_.data() + head_;
+        const auto center  = delay();
+        auto accumulated   = static_cast<T>(0);
+        for (size_type i = 0; i < coefficients_.size(); ++i) {
+            const auto n = 2 * i + 1;
+            accumulated += coefficients_[i] * (window[center - n] - window[center + n]);
+        }
+        return complex_type(window[center], accumulated);
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_HILBERT_FILTER_H
@@ -24,6 +24,7 @@
 
 #include <edsp/filter/internal/bilinear/layout_base.hpp>
 #include <edsp/filter/biquad_cascade.hpp>
+#include <edsp/filter/biquad_parallel.hpp>
 #include <complex>
 
 namespace edsp { namespace filter {
@@ -96,6 +97,13 @@ namespace edsp { namespace filter {
             return make_cascade(digital_);
         }
 
+        template <typename... Args>
+        biquad_parallel<T, (MaxDigital + 1) / 2> design_parallel(Args... arg) {
+            auto* designer = static_cast<Designer*>(this);
+            designer->operator()(arg...);
+            return make_parallel(digital_);
+        }
+
         constexpr const analog_type& analog_layout() const noexcept {
             return analog_;
         }
@@ -23,6 +23,7 @@
 #define EDSP_LAYOUT_BASE_HPP
 
 #include <edsp/math/numeric.hpp>
+#include <edsp/math/complex.hpp>
 #include <edsp/meta/expects.hpp>
 #include <edsp/meta/ensure.hpp>
 #include <complex>
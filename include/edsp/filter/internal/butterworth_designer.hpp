@@ -173,6 +173,12 @@ namespace edsp { namespace filter {
             -> decltype(butterworth::LowPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return butterworth::LowPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(butterworth::LowPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return butterworth::LowPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -182,6 +188,12 @@ namespace edsp { namespace filter {
             -> decltype(butterworth::HighPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return butterworth::HighPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(butterworth::HighPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return butterworth::HighPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -191,6 +203,12 @@ namespace edsp { namespace filter {
             -> decltype(butterworth::BandPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return butterworth::BandPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(butterworth::BandPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return butterworth::BandPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -200,6 +218,12 @@ namespace edsp { namespace filter {
             -> decltype(butterworth::BandStopPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return butterworth::BandStopPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(butterworth::BandStopPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return butterworth::BandStopPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -209,6 +233,12 @@ namespace edsp { namespace filter {
             -> decltype(butterworth::LowShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return butterworth::LowShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(butterworth::LowShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return butterworth::LowShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -218,6 +248,12 @@ namespace edsp { namespace filter {
             -> decltype(butterworth::HighShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return butterworth::HighShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(butterworth::HighShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return butterworth::HighShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -227,6 +263,12 @@ namespace edsp { namespace filter {
             -> decltype(butterworth::BandShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return butterworth::BandShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(butterworth::BandShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return butterworth::BandShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
 }} // namespace edsp::filter
@@ -199,6 +199,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevII::LowPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevII::LowPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevII::LowPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevII::LowPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -208,6 +214,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevII::HighPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevII::HighPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevII::HighPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevII::HighPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -217,6 +229,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevII::BandPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevII::BandPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevII::BandPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevII::BandPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -226,6 +244,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevII::BandStopPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevII::BandStopPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevII::BandStopPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevII::BandStopPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -235,6 +259,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevII::LowShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevII::LowShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevII::LowShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevII::LowShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -244,6 +274,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevII::HighShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevII::HighShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevII::HighShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevII::HighShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -253,6 +289,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevII::BandShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevII::BandShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevII::BandShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevII::BandShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
 }} // namespace edsp::filter
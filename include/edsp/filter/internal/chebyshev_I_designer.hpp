@@ -199,6 +199,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevI::LowPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevI::LowPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevI::LowPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevI::LowPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -208,6 +214,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevI::HighPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevI::HighPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevI::HighPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevI::HighPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -217,6 +229,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevI::BandPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevI::BandPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevI::BandPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevI::BandPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -226,6 +244,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevI::BandStopPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevI::BandStopPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevI::BandStopPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevI::BandStopPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -235,6 +259,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevI::LowShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevI::LowShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevI::LowShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevI::LowShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -244,6 +274,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevI::HighShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevI::HighShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevI::HighShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevI::HighShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
     template <typename T, std::size_t MaxOrder>
@@ -253,6 +289,12 @@ namespace edsp { namespace filter {
             -> decltype(chebyshevI::BandShelfPass<T, MaxOrder>{}.design(std::declval<Arg&&>()...)) {
             return chebyshevI::BandShelfPass<T, MaxOrder>{}.design(arg...);
         }
+
+        template <typename... Arg>
+        constexpr auto parallel(Arg... arg)
+            -> decltype(chebyshevI::BandShelfPass<T, MaxOrder>{}.design_parallel(std::declval<Arg&&>()...)) {
+            return chebyshevI::BandShelfPass<T, MaxOrder>{}.design_parallel(arg...);
+        }
     };
 
 }} // namespace edsp::filter
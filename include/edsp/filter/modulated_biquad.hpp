@@ -0,0 +1,240 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: modulated_biquad.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_FILTER_MODULATED_BIQUAD_HPP
+#define EDSP_FILTER_MODULATED_BIQUAD_HPP
+
+#include <edsp/filter/biquad.hpp>
+#include <array>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @brief The modulated_biquad class implements a Biquad filter whose coefficients can change while it runs.
+     *
+     * Unlike the setters of the %biquad class, updating the coefficients does not reset the state of the filter,
+     * and the new coefficients can be reached with a linear ramp over a number of samples, so automating a
+     * parameter from a control signal does not produce clicks.
+     *
+     * The set of stable coefficients (a1, a2) is convex, so every intermediate set of coefficients of a ramp between
+     * two stable filters describes a stable filter. That does not make the time-varying recursion stable: switching
+     * between stable poles can still amplify the state. The ramped filter behaves as its frozen filters only when
+     * the coefficients change slowly with respect to the decay of the filter, so ramps should last several times
+     * the time constant 1 / (1 - r) samples of the poles of radius r, and be longer for sharp resonances.
+     *
+     * The filter uses the Transposed Direct Form II of the %biquad class.
+     *
+     * @tparam T Value type.
+     * @see biquad, RBJFilterDesigner
+     */
+    template <typename T>
+    class modulated_biquad {
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Creates an identity %modulated_biquad.
+         */
+        modulated_biquad() noexcept;
+
+        /**
+         * @brief Creates a %modulated_biquad with the coefficients of the given filter.
+         * @param filter Biquad filter holding the initial coefficients.
+         */
+        explicit modulated_biquad(const biquad<T>& filter) noexcept;
+
+        /**
+         * @brief Returns a Biquad with the current coefficients.
+         */
+        biquad<T> coefficients() const noexcept;
+
+        /**
+         * @brief Checks if the coefficients are still moving towards a target.
+         */
+        bool ramping() const noexcept;
+
+        /**
+         * @brief Updates the coefficients immediately, keeping the state of the filter.
+         * @param filter Biquad filter holding the new coefficients.
+         */
+        void set(const biquad<T>& filter) noexcept;
+
+        /**
+         * @brief Moves the coefficients linearly towards the ones of the given filter, keeping the state of the filter.
+         *
+         * The coefficients change every sample and reach the target after the given number of samples. A new ramp
+         * starts from the current coefficients, even if the previous one has not finished. Short ramps between
+         * filters with poles close to the unit circle may transiently amplify the signal, see the class description.
+         *
+         * @param filter Biquad filter holding the target coefficients.
+         * @param samples Length of the ramp in samples. If zero, the coefficients are updated immediately.
+         */
+        void ramp(const biquad<T>& filter, size_type samples) noexcept;
+
+        /**
+         * @brief Reset the filter to the original state, keeping the coefficients.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Filters the signal in the range [first, last) and stores the result in another range, beginning at
+         * d_first.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Computes the output of filtering one digital time-step.
+         * @param value Input value to be filtered.
+         * @return Filtered value.
+         */
+        value_type tick(value_type value) noexcept;
+
+    private:
+        // Coefficients stored as b0, b1, b2, a1, a2.
+        using coefficients_type = std::array<value_type, 5>;
+
+        static coefficients_type unpack(const biquad<T>& filter) noexcept;
+
+        coefficients_type current_{};
+        coefficients_type target_{};
+        coefficients_type increment_{};
+        size_type remaining_{0};
+        value_type w0_{0};
+        value_type w1_{0};
+    };
+
+    template <typename T>
+    modulated_biquad<T>::modulated_biquad() noexcept : modulated_biquad(biquad<T>()) {}
+
+    template <typename T>
+    modulated_biquad<T>::modulated_biquad(const biquad<T>& filter) noexcept {
+        set(filter);
+    }
+
+    template <typename T>
+    typename modulated_biquad<T>::coefficients_type modulated_biquad<T>::unpack(const biquad<T>& filter) noexcept {
+        return {{filter.b0(), filter.b1(), filter.b2(), filter.a1(), filter.a2()}};
+    }
+
+    template <typename T>
+    biquad<T> modulated_biquad<T>::coefficients() const noexcept {
+        return biquad<T>(1, current_[3], current_[4], current_[0], current_[1], current_[2]);
+    }
+
+    template <typename T>
+    bool modulated_biquad<T>::ramping() const noexcept {
+        return remaining_ > 0;
+    }
+
+    template <typename T>
+    void modulated_biquad<T>::set(const biquad<T>& filter) noexcept {
+        current_   = unpack(filter);
+        target_    = current_;
+        remaining_ = 0;
+    }
+
+    template <typename T>
+    void modulated_biquad<T>::ramp(const biquad<T>& filter, size_type samples) noexcept {
+        if (samples == 0) {
+            set(filter);
+            return;
+        }
+        target_ = unpack(filter);
+        for (size_type i = 0; i < target_.size(); ++i) {
+            increment_[i] = (target_[i] - current_[i]) / static_cast<value_type>(samples);
+        }
+        remaining_ = samples;
+    }
+
+    template <typename T>
+    void modulated_biquad<T>::reset() noexcept {
+        w0_ = 0;
+        w1_ = 0;
+    }
+
+    template <typename T>
+    typename modulated_biquad<T>::value_type modulated_biquad<T>::tick(value_type value) noexcept {
+        value_type out = 0;
+        filter(&value, &value + 1, &out);
+        return out;
+    }
+
+    template <typename T>
+    template <typename InputIt, typename OutputIt>
+    void modulated_biquad<T>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        auto b0 = current_[0], b1 = current_[1], b2 = current_[2], a1 = current_[3], a2 = current_[4];
+        auto w0 = w0_, w1 = w1_;
+
+        // The ramp and the steady part are separate loops, so the steady part runs as fast as biquad::filter.
+        if (remaining_ > 0) {
+            const auto db0 = increment_[0], db1 = increment_[1], db2 = increment_[2];
+            const auto da1 = increment_[3], da2 = increment_[4];
+            for (; first != last && remaining_ > 1; ++first, ++d_first, --remaining_) {
+                b0 += db0;
+                b1 += db1;
+                b2 += db2;
+                a1 += da1;
+                a2 += da2;
+                const auto value = static_cast<value_type>(*first);
+                const auto out   = b0 * value + w0;
+                w0               = b1 * value - a1 * out + w1;
+                w1               = b2 * value - a2 * out;
+                *d_first         = out;
+            }
+            if (first != last) {
+                // The last step of the ramp lands exactly on the target, without accumulated rounding errors.
+                b0               = target_[0];
+                b1               = target_[1];
+                b2               = target_[2];
+                a1               = target_[3];
+                a2               = target_[4];
+                remaining_       = 0;
+                const auto value = static_cast<value_type>(*first);
+                const auto out   = b0 * value + w0;
+                w0               = b1 * value - a1 * out + w1;
+                w1               = b2 * value - a2 * out;
+                *d_first         = out;
+                ++first;
+                ++d_first;
+            }
+        }
+
+        for (; first != last; ++first, ++d_first) {
+            const auto value = static_cast<value_type>(*first);
+            const auto out   = b0 * value + w0;
+            w0               = b1 * value - a1 * out + w1;
+            w1               = b2 * value - a2 * out;
+            *d_first         = out;
+        }
+        current_ = {{b0, b1, b2, a1, a2}};
+        w0_      = w0;
+        w1_      = w1;
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_MODULATED_BIQUAD_HPP
@@ -22,8 +22,7 @@
 #ifndef EDSP_FILTER_MOVING_MEDIAN_FILTER_H
 #define EDSP_FILTER_MOVING_MEDIAN_FILTER_H
 
-#include <edsp/types/ring_buffer.hpp>
-#include <edsp/statistics/median.hpp>
+#include <edsp/filter/moving_quantile_filter.hpp>
 
 namespace edsp { namespace filter {
 
@@ -35,6 +34,7 @@ namespace edsp { namespace filter {
      * the median of the initial fixed subset of the number series. Then the subset is modified by "shifting forward";
      * that is, excluding the first number of the series and including the next value in the subset.
      *
+     * Every sample costs O(log N) operations, see %moving_quantile.
      *
      * @tparam T  Type of element.
      * @tparam Allocator  Allocator type, defaults to std::allocator<T>.
@@ -58,7 +58,7 @@ namespace edsp { namespace filter {
         size_type size() const;
 
         /**
-         *  @brief Resizes the moving window to the specified number of elements.
+         *  @brief Resizes the moving window to the specified number of elements and empties it.
          *  @param N Number of elements the moving window should contain.
          */
         void resize(size_type N);
@@ -86,21 +86,20 @@ namespace edsp { namespace filter {
         value_type operator()(value_type tick);
 
     private:
-        edsp::ring_buffer<T, Allocator> window_;
-        T accumulated_{0};
+        moving_quantile<T, Allocator> window_;
     };
 
     template <typename T, typename Allocator>
-    moving_median<T, Allocator>::moving_median(size_type N) : window_(N, T()) {}
+    moving_median<T, Allocator>::moving_median(size_type N) : window_(N, 0.5) {}
 
     template <typename T, typename Allocator>
     typename moving_median<T, Allocator>::size_type moving_median<T, Allocator>::size() const {
-        return window_.capacity();
+        return window_.size();
     }
 
     template <typename T, typename Allocator>
     void moving_median<T, Allocator>::reset() {
-        window_.clear();
+        window_.reset();
     }
 
     template <typename T, typename Allocator>
@@ -116,8 +115,7 @@ namespace edsp { namespace filter {
 
     template <typename T, typename Allocator>
     typename moving_median<T, Allocator>::value_type moving_median<T, Allocator>::operator()(value_type tick) {
-        window_.push_back(tick);
-        return statistics::median(window_.cbegin(), window_.cend());
+        return window_(tick);
     }
 
 }} // namespace edsp::filter
@@ -0,0 +1,301 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: moving_quantile_filter.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+#ifndef EDSP_FILTER_MOVING_QUANTILE_FILTER_H
+#define EDSP_FILTER_MOVING_QUANTILE_FILTER_H
+
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @class moving_quantile
+     * @brief This class implement a moving quantile (rolling quantile or running quantile) filter.
+     *
+     * Given a series of numbers and a fixed subset size, every output is the q-quantile of the last elements of the
+     * series, interpolated linearly between the two closest order statistics as the default method of numpy.quantile.
+     * With q = 0.5 it is a moving median. The interpolation is computed in floating point, and rounded to the nearest
+     * integer when T is an integral type.
+     *
+     * The elements of the window are split in two heaps: a max-heap with the smallest ones, up to the requested order
+     * statistic, and a min-heap with the rest. Every element of the window knows its position in its heap, so the
+     * oldest element is replaced in place and both heaps are repaired in O(log N) operations per sample, without
+     * allocating memory.
+     *
+     * @tparam T  Type of element.
+     * @tparam Allocator  Allocator type, defaults to std::allocator<T>.
+     */
+    template <typename T, typename Allocator = std::allocator<T>>
+    class moving_quantile {
+    public:
+        using size_type  = std::size_t;
+        using value_type = T;
+
+        /**
+         *  @brief Creates a %moving_quantile with a window of length N, initially filled with zeros.
+         *  @param N Length of the moving quantile window.
+         *  @param q Quantile to compute, in the range [0, 1].
+         */
+        moving_quantile(size_type N, double q);
+
+        /**
+         *  @brief Returns the size of the moving window.
+         *  @returns Number of elements in the moving window.
+         */
+        size_type size() const;
+
+        /**
+         *  @brief Returns the quantile computed by the filter.
+         */
+        double quantile() const;
+
+        /**
+         *  @brief Resizes the moving window to the specified number of elements and empties it.
+         *  @param N Number of elements the moving window should contain.
+         */
+        void resize(size_type N);
+
+        /**
+         * @brief Reset the moving window to the original state.
+         *
+         * Until the window is full again, the output is the quantile of the elements received since the reset.
+         */
+        void reset();
+
+        /**
+         * @brief Applies a moving quantile filter to the elements in the range [first, last) and stores the result
+         * in another range, beginning at d_first.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Applies a moving quantile filter to the single element
+         * @return The output of the filter.
+         */
+        value_type operator()(value_type tick);
+
+    private:
+        using index_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_type>;
+        using flag_allocator  = typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+        using heap_type       = std::vector<size_type, index_allocator>;
+        using real_type       = typename std::common_type<value_type, double>::type;
+
+        // Number of elements of the lower heap for a window of the given number of elements.
+        size_type lower_size(size_type count) const;
+
+        bool before(bool lower, size_type left, size_type right) const;
+        void swap_nodes(bool lower, size_type i, size_type j);
+        void sift_up(bool lower, size_type i);
+        void sift_down(bool lower, size_type i);
+        void push(bool lower, size_type slot);
+        size_type pop(bool lower);
+        void exchange_tops();
+
+        std::vector<T, Allocator> values_;
+        std::vector<size_type, index_allocator> position_;
+        std::vector<char, flag_allocator> lower_;
+        heap_type low_;
+        heap_type high_;
+        double quantile_;
+        size_type count_{0};
+        size_type oldest_{0};
+    };
+
+    template <typename T, typename Allocator>
+    moving_quantile<T, Allocator>::moving_quantile(size_type N, double q) : quantile_(q) {
+        meta::expects(q >= 0 && q <= 1, "The quantile must be in the range [0, 1]");
+        resize(N);
+        for (size_type i = 0; i < N; ++i) {
+            operator()(0);
+        }
+    }
+
+    template <typename T, typename Allocator>
+    typename moving_quantile<T, Allocator>::size_type moving_quantile<T, Allocator>::size() const {
+        return values_.size();
+    }
+
+    template <typename T, typename Allocator>
+    double moving_quantile<T, Allocator>::quantile() const {
+        return quantile_;
+    }
+
+    template <typename T, typename Allocator>
+    void moving_quantile<T, Allocator>::resize(size_type N) {
+        meta::expects(N > 0, "The window can not be empty");
+        values_.resize(N);
+        position_.resize(N);
+        lower_.resize(N);
+        low_.reserve(N);
+        high_.reserve(N);
+        reset();
+    }
+
+    template <typename T, typename Allocator>
+    void moving_quantile<T, Allocator>::reset() {
+        low_.clear();
+        high_.clear();
+        count_  = 0;
+        oldest_ = 0;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIt, typename OutputIt>
+    void moving_quantile<T, Allocator>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        std::transform(first, last, d_first, std::ref(*this));
+    }
+
+    template <typename T, typename Allocator>
+    typename moving_quantile<T, Allocator>::size_type moving_quantile<T, Allocator>::lower_size(size_type count) const {
+        return static_cast<size_type>(quantile_ * static_cast<double>(count - 1)) + 1;
+    }
+
+    template <typename T, typename Allocator>
+    bool moving_quantile<T, Allocator>::before(bool lower, size_type left, size_type right) const {
+        return lower ? values_[left] > values_[right] : values_[left] < values_[right];
+    }
+
+    template <typename T, typename Allocator>
+    void moving_quantile<T, Allocator>::swap_nodes(bool lower, size_type i, size_type j) {
+        auto& heap = lower ? low_ : high_;
+        std::swap(heap[i], heap[j]);
+        position_[heap[i]] = i;
+        position_[heap[j]] = j;
+    }
+
+    template <typename T, typename Allocator>
+    void moving_quantile<T, Allocator>::sift_up(bool lower, size_type i) {
+        const auto& heap = lower ? low_ : high_;
+        while (i > 0) {
+            const auto parent = (i - 1) / 2;
+            if (!before(lower, heap[i], heap[parent])) {
+                break;
+            }
+            swap_nodes(lower, i, parent);
+            i = parent;
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void moving_quantile<T, Allocator>::sift_down(bool lower, size_type i) {
+        const auto& heap = lower ? low_ : high_;
+        for (;;) {
+            const auto left  = 2 * i + 1;
+            const auto right = left + 1;
+            auto next        = i;
+            if (left < heap.size() && before(lower, heap[left], heap[next])) {
+                next = left;
+            }
+            if (right < heap.size() && before(lower, heap[right], heap[next])) {
+                next = right;
+            }
+            if (next == i) {
+                break;
+            }
+            swap_nodes(lower, i, next);
+            i = next;
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void moving_quantile<T, Allocator>::push(bool lower, size_type slot) {
+        auto& heap      = lower ? low_ : high_;
+        lower_[slot]    = lower;
+        position_[slot] = heap.size();
+        heap.push_back(slot);
+        sift_up(lower, heap.size() - 1);
+    }
+
+    template <typename T, typename Allocator>
+    typename moving_quantile<T, Allocator>::size_type moving_quantile<T, Allocator>::pop(bool lower) {
+        auto& heap      = lower ? low_ : high_;
+        const auto slot = heap.front();
+        swap_nodes(lower, 0, heap.size() - 1);
+        heap.pop_back();
+        sift_down(lower, 0);
+        return slot;
+    }
+
+    template <typename T, typename Allocator>
+    void moving_quantile<T, Allocator>::exchange_tops() {
+        // A single element may break the order between the heaps: the largest lower element becomes greater than
+        // the smallest higher one. Exchanging both tops restores it.
+        if (low_.empty() || high_.empty() || !(values_[low_.front()] > values_[high_.front()])) {
+            return;
+        }
+        std::swap(low_.front(), high_.front());
+        lower_[low_.front()]     = true;
+        lower_[high_.front()]    = false;
+        position_[low_.front()]  = 0;
+        position_[high_.front()] = 0;
+        sift_down(true, 0);
+        sift_down(false, 0);
+    }
+
+    template <typename T, typename Allocator>
+    typename moving_quantile<T, Allocator>::value_type moving_quantile<T, Allocator>::operator()(value_type tick) {
+        const auto slot = oldest_;
+        oldest_         = (oldest_ + 1 == values_.size()) ? 0 : oldest_ + 1;
+        values_[slot]   = tick;
+        if (count_ == values_.size()) {
+            // The oldest element is replaced in place.
+            const bool lower = lower_[slot] != 0;
+            sift_up(lower, position_[slot]);
+            sift_down(lower, position_[slot]);
+            exchange_tops();
+        } else {
+            ++count_;
+            push(true, slot);
+            exchange_tops();
+            const auto expected = lower_size(count_);
+            while (low_.size() > expected) {
+                push(false, pop(true));
+            }
+            while (low_.size() < expected) {
+                push(true, pop(false));
+            }
+        }
+
+        const auto position = quantile_ * static_cast<double>(count_ - 1);
+        const auto fraction = static_cast<real_type>(position - static_cast<double>(low_.size() - 1));
+        const auto value    = values_[low_.front()];
+        if (fraction > 0 && !high_.empty()) {
+            const auto low    = static_cast<real_type>(value);
+            const auto result = low + fraction * (static_cast<real_type>(values_[high_.front()]) - low);
+            return static_cast<value_type>(std::is_integral<value_type>::value ? std::round(result) : result);
+        }
+        return value;
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_MOVING_QUANTILE_FILTER_H
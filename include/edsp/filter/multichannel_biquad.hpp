@@ -0,0 +1,195 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: multichannel_biquad.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_FILTER_MULTICHANNEL_BIQUAD_HPP
+#define EDSP_FILTER_MULTICHANNEL_BIQUAD_HPP
+
+#include <edsp/filter/biquad.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @brief The multichannel_biquad class implements a bank of independent Biquad filters, one per channel, that
+     * filters interleaved signals.
+     *
+     * The coefficients and the states of all the channels are stored in separate arrays, so every time-step updates
+     * all the channels with the same operations over contiguous data. The compiler maps the channels to SIMD lanes:
+     * filtering 4 or 8 channels costs roughly the same as filtering a single one.
+     *
+     * Every channel uses the Transposed Direct Form II of the %biquad class.
+     *
+     * @tparam T Value type.
+     * @tparam Channels Number of channels.
+     * @see biquad
+     */
+    template <typename T, std::size_t Channels>
+    class multichannel_biquad {
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Creates a %multichannel_biquad where every channel is an identity filter.
+         */
+        multichannel_biquad() noexcept;
+
+        /**
+         * @brief Creates a %multichannel_biquad where every channel uses the coefficients of the given filter.
+         * @param filter Biquad filter to be replicated.
+         */
+        explicit multichannel_biquad(const biquad<T>& filter) noexcept;
+
+        /**
+         * @brief Returns the number of channels.
+         */
+        constexpr size_type channels() const noexcept;
+
+        /**
+         * @brief Updates the coefficients of one channel and resets its state.
+         * @param channel Index of the channel.
+         * @param filter Biquad filter holding the new coefficients.
+         */
+        void set(size_type channel, const biquad<T>& filter);
+
+        /**
+         * @brief Reset all the channels to the original state.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Filters the interleaved signal in the range [first, last) and stores the result in another range,
+         * beginning at d_first.
+         * @param first Input iterator defining the beginning of the interleaved input range.
+         * @param last Input iterator defining the ending of the interleaved input range. The number of elements
+         * should be a multiple of the number of channels.
+         * @param d_first Output iterator defining the beginning of the interleaved destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Computes the output of filtering one time-step of all the channels.
+         * @param input Pointer to the input values, one per channel.
+         * @param output Pointer to the output values, one per channel.
+         */
+        void tick(const value_type* input, value_type* output) noexcept;
+
+    private:
+        using lanes = std::array<value_type, Channels>;
+
+        lanes b0_;
+        lanes b1_;
+        lanes b2_;
+        lanes a1_;
+        lanes a2_;
+        lanes w0_;
+        lanes w1_;
+    };
+
+    template <typename T, std::size_t Channels>
+    multichannel_biquad<T, Channels>::multichannel_biquad() noexcept : multichannel_biquad(biquad<T>()) {}
+
+    template <typename T, std::size_t Channels>
+    multichannel_biquad<T, Channels>::multichannel_biquad(const biquad<T>& filter) noexcept {
+        b0_.fill(filter.b0());
+        b1_.fill(filter.b1());
+        b2_.fill(filter.b2());
+        a1_.fill(filter.a1());
+        a2_.fill(filter.a2());
+        reset();
+    }
+
+    template <typename T, std::size_t Channels>
+    constexpr typename multichannel_biquad<T, Channels>::size_type multichannel_biquad<T, Channels>::channels() const
+        noexcept {
+        return Channels;
+    }
+
+    template <typename T, std::size_t Channels>
+    void multichannel_biquad<T, Channels>::set(size_type channel, const biquad<T>& filter) {
+        meta::expects(channel < Channels, "Channel out of range");
+        b0_[channel] = filter.b0();
+        b1_[channel] = filter.b1();
+        b2_[channel] = filter.b2();
+        a1_[channel] = filter.a1();
+        a2_[channel] = filter.a2();
+        w0_[channel] = 0;
+        w1_[channel] = 0;
+    }
+
+    template <typename T, std::size_t Channels>
+    void multichannel_biquad<T, Channels>::reset() noexcept {
+        w0_.fill(0);
+        w1_.fill(0);
+    }
+
+    template <typename T, std::size_t Channels>
+    void multichannel_biquad<T, Channels>::tick(const value_type* input, value_type* output) noexcept {
+        for (size_type c = 0; c < Channels; ++c) {
+            const auto value = input[c];
+            const auto out   = b0_[c] * value + w0_[c];
+            w0_[c]           = b1_[c] * value - a1_[c] * out + w1_[c];
+            w1_[c]           = b2_[c] * value - a2_[c] * out;
+            output[c]        = out;
+        }
+    }
+
+    template <typename T, std::size_t Channels>
+    template <typename InputIt, typename OutputIt>
+    void multichannel_biquad<T, Channels>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        meta::expects(std::distance(first, last) % static_cast<std::ptrdiff_t>(Channels) == 0,
+                      "The number of samples must be a multiple of the number of channels");
+        // The frames are copied in blocks into local buffers, which can not alias the input, the output or the state.
+        // It allows the compiler to keep the coefficients and the states in vector registers and to map the channels
+        // to SIMD lanes, even when filtering in place.
+        constexpr size_type block_size = 32 * Channels;
+        std::array<value_type, block_size> input;
+        std::array<value_type, block_size> output;
+        const auto b0 = b0_, b1 = b1_, b2 = b2_, a1 = a1_, a2 = a2_;
+        auto w0 = w0_, w1 = w1_;
+        while (first != last) {
+            size_type count = 0;
+            for (; count < block_size && first != last; ++count, ++first) {
+                input[count] = *first;
+            }
+            for (size_type frame = 0; frame < count; frame += Channels) {
+                for (size_type c = 0; c < Channels; ++c) {
+                    const auto value  = input[frame + c];
+                    const auto out    = b0[c] * value + w0[c];
+                    w0[c]             = b1[c] * value - a1[c] * out + w1[c];
+                    w1[c]             = b2[c] * value - a2[c] * out;
+                    output[frame + c] = out;
+                }
+            }
+            d_first = std::copy(std::cbegin(output), std::cbegin(output) + static_cast<std::ptrdiff_t>(count), d_first);
+        }
+        w0_ = w0;
+        w1_ = w1;
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_MULTICHANNEL_BIQUAD_HPP
@@ -0,0 +1,331 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: multichannel_biquad_cascade.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_FILTER_MULTICHANNEL_BIQUAD_CASCADE_HPP
+#define EDSP_FILTER_MULTICHANNEL_BIQUAD_CASCADE_HPP
+
+#include <edsp/filter/biquad.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/ensure.hpp>
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+namespace edsp { namespace filter {
+
+    /**
+     * @brief The multichannel_biquad_cascade class applies the same cascade of Biquad filters to several channels.
+     *
+     * The coefficients of every stage are stored once and shared by all the channels, while the states are stored
+     * per stage in channel-contiguous arrays. Every stage updates all the channels with the same operations over
+     * contiguous data, so the compiler maps the channels to SIMD lanes.
+     *
+     * The class filters interleaved buffers and planar buffers (one buffer per channel) directly, without creating
+     * one %biquad_cascade per channel or de-interleaving the signal.
+     *
+     * @tparam T Value type.
+     * @tparam N Number representing the maximum size (number of Biquad).
+     * @tparam Channels Number of channels.
+     * @see biquad_cascade, multichannel_biquad
+     */
+    template <typename T, std::size_t N, std::size_t Channels>
+    class multichannel_biquad_cascade {
+    public:
+        using value_type      = biquad<T>;
+        using const_reference = const value_type&;
+        using const_iterator  = const value_type*;
+        using size_type       = std::size_t;
+
+        /**
+         * @brief Creates an empty %multichannel_biquad_cascade
+         */
+        multichannel_biquad_cascade() noexcept;
+
+        /**
+         * @brief Returns the number of Biquads
+         * @return Number of biquads
+         */
+        constexpr size_type size() const noexcept;
+
+        /**
+         * @brief Returns the maximum number of Biquads the cascade is able to hold.
+         * @return Maximum number of elements.
+         * @see N
+         */
+        constexpr size_type max_size() const noexcept;
+
+        /**
+         * @brief Returns the capacity the cascade.
+         * @return Capacity of the currently allocated storage.
+         * @see max_size
+         */
+        constexpr size_type capacity() const noexcept;
+
+        /**
+         * @brief Returns the number of channels.
+         */
+        constexpr size_type channels() const noexcept;
+
+        /**
+         * @brief Clear the contents of the cascade.
+         *
+         * Leaves the capacity() of the cascade unchanged.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Reset the states of all the channels to the original state.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Returns a constant reference to the Biquad holding the coefficients of the stage at specified
+         * location pos. No bounds checking is performed.
+         * @param index Position of the element to return.
+         * @return Constant reference to the requested Biquad.
+         */
+        const_reference operator[](size_type index) const noexcept;
+
+        /**
+         * @brief Returns a constant iterator to the first stage of the cascade.
+         */
+        const_iterator begin() const noexcept;
+
+        /**
+         * @brief Returns a constant iterator to the last stage of the cascade.
+         */
+        const_iterator end() const noexcept;
+
+        /**
+         * @brief Appends the given Biquad at the end. The state of the new stage is reset in all the channels.
+         * @param biquad Biquad to append.
+         */
+        void push_back(const biquad<T>& biquad);
+
+        /**
+         * @brief Construct a Biquad in-place at the end.
+         * @param arg Arguments to forward to the constructor of the element
+         */
+        template <typename... Arg>
+        void emplace_back(Arg... arg);
+
+        /**
+         * @brief Filters the interleaved signal in the range [first, last) and stores the result in another range,
+         * beginning at d_first.
+         * @param first Input iterator defining the beginning of the interleaved input range.
+         * @param last Input iterator defining the ending of the interleaved input range. The number of elements
+         * should be a multiple of the number of channels.
+         * @param d_first Output iterator defining the beginning of the interleaved destination range.
+         */
+        template <typename InputIt, typename OutputIt>
+        void filter(InputIt first, InputIt last, OutputIt d_first);
+
+        /**
+         * @brief Filters a planar signal, stored as one buffer per channel.
+         *
+         * The input and output buffers of a channel may be the same buffer.
+         *
+         * @param input Array of Channels pointers to the input buffers.
+         * @param output Array of Channels pointers to the output buffers.
+         * @param frames Number of samples of every buffer.
+         */
+        void filter_planar(const T* const* input, T* const* output, size_type frames);
+
+        /**
+         * @brief Computes the output of filtering one time-step of all the channels.
+         * @param input Pointer to the input values, one per channel.
+         * @param output Pointer to the output values, one per channel.
+         */
+        void tick(const T* input, T* output) noexcept;
+
+    private:
+        using lanes = std::array<T, Channels>;
+
+        static constexpr size_type block_frames = 32;
+        using block = std::array<T, block_frames * Channels>;
+
+        void process(T* buffer, size_type count) noexcept;
+
+        size_type num_stage_{0};
+        std::array<biquad<T>, N> cascade_{};
+        std::array<lanes, N> w0_{};
+        std::array<lanes, N> w1_{};
+    };
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    constexpr typename multichannel_biquad_cascade<T, N, Channels>::size_type
+        multichannel_biquad_cascade<T, N, Channels>::block_frames;
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    multichannel_biquad_cascade<T, N, Channels>::multichannel_biquad_cascade() noexcept {
+        reset();
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    constexpr typename multichannel_biquad_cascade<T, N, Channels>::size_type
+        multichannel_biquad_cascade<T, N, Channels>::size() const noexcept {
+        return num_stage_;
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    constexpr typename multichannel_biquad_cascade<T, N, Channels>::size_type
+        multichannel_biquad_cascade<T, N, Channels>::max_size() const noexcept {
+        return N;
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    constexpr typename multichannel_biquad_cascade<T, N, Channels>::size_type
+        multichannel_biquad_cascade<T, N, Channels>::capacity() const noexcept {
+        return N;
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    constexpr typename multichannel_biquad_cascade<T, N, Channels>::size_type
+        multichannel_biquad_cascade<T, N, Channels>::channels() const noexcept {
+        return Channels;
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    void multichannel_biquad_cascade<T, N, Channels>::clear() noexcept {
+        num_stage_ = 0;
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    void multichannel_biquad_cascade<T, N, Channels>::reset() noexcept {
+        for (size_type i = 0; i < N; ++i) {
+            w0_[i].fill(0);
+            w1_[i].fill(0);
+        }
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    typename multichannel_biquad_cascade<T, N, Channels>::const_reference multichannel_biquad_cascade<T, N, Channels>::
+        operator[](size_type index) const noexcept {
+        return cascade_[index];
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    typename multichannel_biquad_cascade<T, N, Channels>::const_iterator
+        multichannel_biquad_cascade<T, N, Channels>::begin() const noexcept {
+        return std::cbegin(cascade_);
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    typename multichannel_biquad_cascade<T, N, Channels>::const_iterator
+        multichannel_biquad_cascade<T, N, Channels>::end() const noexcept {
+        return std::cbegin(cascade_) + num_stage_;
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    void multichannel_biquad_cascade<T, N, Channels>::push_back(const biquad<T>& biquad) {
+        meta::ensure(num_stage_ < N, "No space available");
+        cascade_[num_stage_] = biquad;
+        w0_[num_stage_].fill(0);
+        w1_[num_stage_].fill(0);
+        num_stage_++;
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    template <typename... Arg>
+    void multichannel_biquad_cascade<T, N, Channels>::emplace_back(Arg... arg) {
+        push_back(biquad<T>(arg...));
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    void multichannel_biquad_cascade<T, N, Channels>::tick(const T* input, T* output) noexcept {
+        lanes buffer;
+        std::copy(input, input + Channels, std::begin(buffer));
+        process(buffer.data(), Channels);
+        std::copy(std::cbegin(buffer), std::cbegin(buffer) + Channels, output);
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    template <typename InputIt, typename OutputIt>
+    void multichannel_biquad_cascade<T, N, Channels>::filter(InputIt first, InputIt last, OutputIt d_first) {
+        meta::expects(std::distance(first, last) % static_cast<std::ptrdiff_t>(Channels) == 0,
+                      "The number of samples must be a multiple of the number of channels");
+        block buffer;
+        while (first != last) {
+            size_type count = 0;
+            for (; count < buffer.size() && first != last; ++count, ++first) {
+                buffer[count] = *first;
+            }
+            process(buffer.data(), count);
+            d_first = std::copy(std::cbegin(buffer), std::cbegin(buffer) + static_cast<std::ptrdiff_t>(count), d_first);
+        }
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    void multichannel_biquad_cascade<T, N, Channels>::filter_planar(const T* const* input, T* const* output,
+                                                                     size_type frames) {
+        block buffer;
+        for (size_type offset = 0; offset < frames; offset += block_frames) {
+            const auto length = std::min(block_frames, frames - offset);
+            for (size_type c = 0; c < Channels; ++c) {
+                const auto* channel = input[c] + offset;
+                for (size_type i = 0; i < length; ++i) {
+                    buffer[i * Channels + c] = channel[i];
+                }
+            }
+            process(buffer.data(), length * Channels);
+            for (size_type c = 0; c < Channels; ++c) {
+                auto* channel = output[c] + offset;
+                for (size_type i = 0; i < length; ++i) {
+                    channel[i] = buffer[i * Channels + c];
+                }
+            }
+        }
+    }
+
+    template <typename T, std::size_t N, std::size_t Channels>
+    void multichannel_biquad_cascade<T, N, Channels>::process(T* buffer, size_type count) noexcept {
+        // The block is filtered one stage at a time, with the states of the stage held in local arrays that can not
+        // alias the buffer. Every equation of the frame is a separate loop over the channels, which the compiler
+        // turns into a few SIMD operations.
+        for (size_type i = 0; i < num_stage_; ++i) {
+            const auto b0 = cascade_[i].b0(), b1 = cascade_[i].b1(), b2 = cascade_[i].b2();
+            const auto a1 = cascade_[i].a1(), a2 = cascade_[i].a2();
+            auto w0       = w0_[i];
+            auto w1       = w1_[i];
+            for (size_type frame = 0; frame < count; frame += Channels) {
+                lanes value;
+                lanes out;
+                std::copy(buffer + frame, buffer + frame + Channels, std::begin(value));
+                for (size_type c = 0; c < Channels; ++c) {
+                    out[c] = b0 * value[c] + w0[c];
+                }
+                for (size_type c = 0; c < Channels; ++c) {
+                    w0[c] = b1 * value[c] - a1 * out[c] + w1[c];
+                }
+                for (size_type c = 0; c < Channels; ++c) {
+                    w1[c] = b2 * value[c] - a2 * out[c];
+                }
+                std::copy(std::cbegin(out), std::cend(out), buffer + frame);
+            }
+            w0_[i] = w0;
+            w1_[i] = w1;
+        }
+    }
+
+}} // namespace edsp::filter
+
+#endif // EDSP_FILTER_MULTICHANNEL_BIQUAD_CASCADE_HPP
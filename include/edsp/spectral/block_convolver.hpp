@@ -0,0 +1,207 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: block_convolver.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_BLOCK_CONVOLVER_HPP
+#define EDSP_BLOCK_CONVOLVER_HPP
+
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/math/numeric.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    /**
+     * @brief The convolution_method enum defines the algorithms used to convolve a stream block by block.
+     */
+    enum class convolution_method {
+        OverlapSave, /*!< Keeps the last input samples and discards the circularly aliased outputs */
+        OverlapAdd   /*!< Transforms zero-padded blocks and adds the overlapping tails */
+    };
+
+    /**
+     * @class block_convolver
+     * @brief This class convolves a stream of arbitrary length with a fixed kernel (e.g. a long FIR filter or a room
+     * impulse response) in the frequency domain, block by block.
+     *
+     * The kernel is transformed once in the constructor. Every block of up to block_size() input samples costs a
+     * forward and an inverse FFT of size fft_size(), the smallest power of two able to hold the linear convolution of
+     * a block and the kernel. The output has no latency: every pushed sample produces an output sample, and the tail
+     * of the convolution is obtained by pushing zeros.
+     *
+     * All the memory is allocated in the constructor, so processing does not allocate.
+     *
+     * @tparam T Floating point type.
+     * @tparam RAllocator Allocator type of the real buffers, defaults to aligned_allocator<T>.
+     * @tparam CAllocator Allocator type of the complex buffers, defaults to aligned_allocator<std::complex<T>>.
+     */
+    template <typename T, typename RAllocator = aligned_allocator<T>,
+              typename CAllocator = aligned_allocator<std::complex<T>>>
+    class block_convolver {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %block_convolver for the kernel stored in the range [first, last).
+         * @param first Input iterator defining the beginning of the kernel.
+         * @param last Input iterator defining the ending of the kernel.
+         * @param block_size Maximum number of samples processed with a single pair of transforms.
+         * @param method Algorithm used to convolve the blocks.
+         */
+        template <typename InputIt>
+        block_convolver(InputIt first, InputIt last, size_type block_size,
+                        convolution_method method = convolution_method::OverlapSave) :
+            kernel_size_(static_cast<size_type>(std::distance(first, last))),
+            block_(block_size),
+            nfft_(std::max<size_type>(32, math::next_power_two(kernel_size_ + block_size - 1))),
+            method_(method),
+            input_(nfft_, static_cast<value_type>(0)),
+            output_(nfft_, static_cast<value_type>(0)),
+            overlap_(nfft_, static_cast<value_type>(0)),
+            kernel_(make_fft_size(nfft_)),
+            spectrum_(make_fft_size(nfft_)),
+            engine_(nfft_) {
+            meta::expects(kernel_size_ > 0, "Not expecting empty kernel");
+            meta::expects(block_size > 0, "Not expecting empty blocks");
+            std::copy(first, last, std::begin(input_));
+            engine_.dft(meta::data(input_), meta::data(kernel_));
+
+            // Folds the scaling of the inverse transform into the kernel.
+            const auto scaling = static_cast<value_type>(nfft_);
+            for (auto& bin : kernel_) {
+                bin /= scaling;
+            }
+            reset();
+        }
+
+        /**
+         * @brief Returns the number of samples of the kernel.
+         */
+        inline size_type kernel_size() const noexcept {
+            return kernel_size_;
+        }
+
+        /**
+         * @brief Returns the maximum number of samples processed with a single pair of transforms.
+         */
+        inline size_type block_size() const noexcept {
+            return block_;
+        }
+
+        /**
+         * @brief Returns the size of the transforms.
+         */
+        inline size_type fft_size() const noexcept {
+            return nfft_;
+        }
+
+        /**
+         * @brief Returns the algorithm used to convolve the blocks.
+         */
+        inline convolution_method method() const noexcept {
+            return method_;
+        }
+
+        /**
+         * @brief Discards the history of the stream.
+         */
+        inline void reset() {
+            std::fill(std::begin(input_), std::end(input_), static_cast<value_type>(0));
+            std::fill(std::begin(overlap_), std::end(overlap_), static_cast<value_type>(0));
+        }
+
+        /**
+         * @brief Convolves the samples in the range [first, last) with the kernel and stores the result in another
+         * range, beginning at d_first.
+         *
+         * The range can have any length, it is processed in blocks of at most block_size() samples.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt process(InputIt first, InputIt last, OutputIt d_first) {
+            while (first != last) {
+                const auto count = std::min(static_cast<size_type>(std::distance(first, last)), block_);
+                const auto next  = std::next(first, static_cast<std::ptrdiff_t>(count));
+                d_first = (method_ == convolution_method::OverlapSave) ? overlap_save(first, next, count, d_first)
+                                                                       : overlap_add(first, next, count, d_first);
+                first = next;
+            }
+            return d_first;
+        }
+
+    private:
+        inline void convolve() {
+            engine_.dft(meta::data(input_), meta::data(spectrum_));
+            std::transform(std::cbegin(spectrum_), std::cend(spectrum_), std::cbegin(kernel_), std::begin(spectrum_),
+                           std::multiplies<complex_type>());
+            engine_.idft(meta::data(spectrum_), meta::data(output_));
+        }
+
+        // The input buffer keeps the last fft_size() samples of the stream. Only the first kernel_size() - 1 outputs
+        // of the circular convolution are aliased, the last count ones are valid.
+        template <typename InputIt, typename OutputIt>
+        OutputIt overlap_save(InputIt first, InputIt last, size_type count, OutputIt d_first) {
+            std::copy(std::begin(input_) + count, std::end(input_), std::begin(input_));
+            std::copy(first, last, std::end(input_) - count);
+            convolve();
+            return std::copy(std::cend(output_) - count, std::cend(output_), d_first);
+        }
+
+        // The linear convolution of a zero-padded block fits in the transform, its tail is accumulated and added to
+        // the outputs of the following blocks.
+        template <typename InputIt, typename OutputIt>
+        OutputIt overlap_add(InputIt first, InputIt last, size_type count, OutputIt d_first) {
+            std::copy(first, last, std::begin(input_));
+            std::fill(std::begin(input_) + count, std::end(input_), static_cast<value_type>(0));
+            convolve();
+            std::transform(std::cbegin(overlap_), std::cend(overlap_), std::cbegin(output_), std::begin(overlap_),
+                           std::plus<value_type>());
+            d_first = std::copy(std::cbegin(overlap_), std::cbegin(overlap_) + count, d_first);
+            std::copy(std::begin(overlap_) + count, std::end(overlap_), std::begin(overlap_));
+            std::fill(std::end(overlap_) - count, std::end(overlap_), static_cast<value_type>(0));
+            return d_first;
+        }
+
+        size_type kernel_size_;
+        size_type block_;
+        size_type nfft_;
+        convolution_method method_;
+        std::vector<value_type, RAllocator> input_;
+        std::vector<value_type, RAllocator> output_;
+        std::vector<value_type, RAllocator> overlap_;
+        std::vector<complex_type, CAllocator> kernel_;
+        std::vector<complex_type, CAllocator> spectrum_;
+        fft_engine<value_type> engine_;
+    };
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_BLOCK_CONVOLVER_HPP
@@ -23,10 +23,85 @@
 #define EDSP_CEPSTRUM_HPP
 
 #include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <vector>
 
 namespace edsp { inline namespace spectral {
 
+    /**
+     * @class cepstrum_analyzer
+     * @brief This class computes the cepstrum of sequences of a fixed size, the reusable counterpart of %cepstrum.
+     *
+     * The plans and the aligned scratch buffers are created in the constructor, so the calls do not allocate.
+     *
+     * @tparam T Floating point type.
+     * @tparam RAllocator Allocator type of the real buffers, defaults to aligned_allocator<T>.
+     * @tparam CAllocator Allocator type of the complex buffers, defaults to aligned_allocator<std::complex<T>>.
+     * @see cepstrum
+     */
+    template <typename T, typename RAllocator = aligned_allocator<T>,
+              typename CAllocator = aligned_allocator<std::complex<T>>>
+    class cepstrum_analyzer {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %cepstrum_analyzer for sequences of the given size.
+         * @param size Number of samples of the sequences.
+         */
+        explicit cepstrum_analyzer(size_type size) :
+            size_(size),
+            input_(2 * size, static_cast<value_type>(0)),
+            output_(2 * size),
+            spectrum_(make_fft_size(2 * size)),
+            engine_(2 * size) {
+            meta::expects(size > 0, "Not expecting empty input");
+        }
+
+        /**
+         * @brief Returns the number of samples of the sequences.
+         */
+        inline size_type size() const noexcept {
+            return size_;
+        }
+
+        /**
+         * @brief Computes the cepstrum of the range [first, last) and stores the first size() samples of the result in
+         * another range, beginning at d_first.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt process(InputIt first, InputIt last, OutputIt d_first) {
+            meta::expects(static_cast<size_type>(std::distance(first, last)) == size_,
+                          "The size of the sequence does not match the size of the analyzer");
+            std::copy(first, last, std::begin(input_));
+            engine_.dft(meta::data(input_), meta::data(spectrum_));
+            for (auto& bin : spectrum_) {
+                bin = complex_type(std::log(std::abs(bin)), 0);
+            }
+            engine_.idft(meta::data(spectrum_), meta::data(output_));
+            const auto factor = static_cast<value_type>(2 * size_);
+            return std::transform(std::cbegin(output_), std::cbegin(output_) + size_, d_first,
+                                  [factor](value_type val) { return val / factor; });
+        }
+
+    private:
+        size_type size_;
+        std::vector<value_type, RAllocator> input_;
+        std::vector<value_type, RAllocator> output_;
+        std::vector<complex_type, CAllocator> spectrum_;
+        fft_engine<value_type> engine_;
+    };
+
     /**
      * @brief Computes the cepstrum of the range [first, last) and stores the result in another range, beginning at d_first.
      *
@@ -39,31 +114,16 @@ namespace edsp { inline namespace spectral {
      * @param first Input iterator defining the beginning of the input range.
      * @param last Input iterator defining the ending of the input range.
      * @param d_first Output iterator defining the beginning of the destination range.
+     * @see cepstrum_analyzer
      */
-    template <typename InputIt, typename OutputIt, typename RAllocator = std::allocator<meta::value_type_t<InputIt>>,
-              typename CAllocator = std::allocator<std::complex<meta::value_type_t<OutputIt>>>>
+    template <typename InputIt, typename OutputIt, typename RAllocator = aligned_allocator<meta::value_type_t<InputIt>>,
+              typename CAllocator = aligned_allocator<std::complex<meta::value_type_t<OutputIt>>>>
     inline void cepstrum(InputIt first, InputIt last, OutputIt d_first) {
         meta::expects(std::distance(first, last) > 0, "Not expecting empty input");
         using value_type = meta::value_type_t<InputIt>;
-        const auto size  = std::distance(first, last);
-        const auto nfft  = 2 * size;
-        fft_engine<value_type> fft_(nfft);
-        fft_engine<value_type> ifft_(nfft);
-
-        std::vector<value_type, RAllocator> temp_input(nfft, static_cast<value_type>(0)), temp_output(nfft);
-        std::copy(first, last, std::begin(temp_input));
-
-        std::vector<std::complex<value_type>, CAllocator> fft_data_(make_fft_size(nfft));
-        fft_.dft(meta::data(temp_input), meta::data(fft_data_));
-
-        std::transform(std::cbegin(fft_data_), std::cend(fft_data_), std::begin(fft_data_),
-                       [](const std::complex<value_type>& val) -> std::complex<value_type> {
-                           return std::complex<value_type>(std::log(std::abs(val)), 0);
-                       });
-
-        ifft_.idft(meta::data(fft_data_), meta::data(temp_output));
-        ifft_.idft_scale(meta::data(temp_output));
-        std::copy(std::cbegin(temp_output), std::cbegin(temp_output) + size, d_first);
+        cepstrum_analyzer<value_type, RAllocator, CAllocator> instance(
+            static_cast<std::size_t>(std::distance(first, last)));
+        instance.process(first, last, d_first);
     }
 
 }} // namespace edsp::spectral
@@ -0,0 +1,343 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: constant_q.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_CONSTANT_Q_HPP
+#define EDSP_CONSTANT_Q_HPP
+
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/windowing/hamming.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/math/numeric.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/data.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    namespace internal {
+
+        // Complex sparse matrix in Compressed Sparse Row layout: the values of the row k are stored in the range
+        // [offsets[k], offsets[k + 1]) of the columns and values arrays.
+        template <typename T, typename Allocator>
+        struct csr_matrix {
+            using size_type = std::size_t;
+
+            csr_matrix() : offsets(1, 0) {}
+
+            inline size_type rows() const noexcept {
+                return offsets.size() - 1;
+            }
+
+            inline size_type nonzeros() const noexcept {
+                return values.size();
+            }
+
+            inline void push_back(size_type column, const std::complex<T>& value) {
+                columns.push_back(column);
+                values.push_back(value);
+            }
+
+            inline void close_row() {
+                offsets.push_back(columns.size());
+            }
+
+            inline std::complex<T> dot(size_type row, const std::complex<T>* x) const {
+                auto accumulated = std::complex<T>(0, 0);
+                for (auto i = offsets[row], end = offsets[row + 1]; i < end; ++i) {
+                    accumulated += x[columns[i]] * values[i];
+                }
+                return accumulated;
+            }
+
+            std::vector<size_type> offsets;
+            std::vector<size_type> columns;
+            std::vector<std::complex<T>, Allocator> values;
+        };
+
+    } // namespace internal
+
+    /**
+     * @class constant_q
+     * @brief This class implements a Constant-Q Transform (CQT), a spectrum with K bins geometrically spaced from
+     * f_min, with a constant number of bins per octave:
+     *
+     * \f[
+     *  f_k = f_{min} 2^{k / b}, \qquad X_k = \frac{1}{N_k} \sum_{n=0}^{N_k-1} x[n] w_k[n] e^{-j 2 \pi f_k n / f_s}
+     * \f]
+     *
+     * where \f$ w_k \f$ is a Hamming window of \f$ N_k = f_s / (\alpha f_k + \gamma) \f$ samples, with
+     * \f$ \alpha = 2^{1/b} - 1 \f$. A null \f$ \gamma \f$ gives a constant quality factor \f$ Q = 1 / \alpha \f$,
+     * while a positive one widens the low frequency bins (variable-Q transform) to improve their time resolution.
+     *
+     * The transform is computed with the Brown-Puckette method: the spectra of all the kernels are computed in the
+     * constructor, the values below a threshold are discarded and the rest are stored in a Compressed Sparse Row
+     * (CSR) matrix. Every frame then costs a single real FFT of fft_size() samples and a sparse matrix-vector product.
+     * All the kernels are centered in the frame. As the input is real, the negative frequencies of the kernels are
+     * folded over the positive half of the spectrum, in a second sparse matrix.
+     *
+     * The frames can be transformed one by one, or extracted every hop_size() samples from a continuous stream.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the internal buffers, defaults to aligned_allocator<T>.
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class constant_q {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %constant_q transform.
+         * @param sample_rate Sampling frequency in Hz.
+         * @param f_min Frequency of the first bin, in Hz.
+         * @param f_max Maximum frequency, in Hz. The last bin is the highest one below this frequency.
+         * @param bins_per_octave Number of bins per octave.
+         * @param hop_size Number of samples between the beginning of two consecutive frames of a stream.
+         * @param threshold Magnitude below which the values of the spectral kernels are discarded.
+         * @param gamma Bandwidth offset in Hz, zero for a constant-Q transform.
+         */
+        constant_q(value_type sample_rate, value_type f_min, value_type f_max, size_type bins_per_octave,
+                   size_type hop_size, value_type threshold = static_cast<value_type>(0.0054),
+                   value_type gamma = 0) :
+            f_min_(f_min),
+            bins_per_octave_(bins_per_octave),
+            hop_(hop_size),
+            nfft_(math::next_power_two(kernel_length(sample_rate, f_min, bins_per_octave, gamma))),
+            buffer_(nfft_, static_cast<value_type>(0)),
+            frame_(nfft_),
+            spectrum_(make_fft_size(nfft_)),
+            engine_(nfft_) {
+            meta::expects(sample_rate > 0, "The sample rate must be positive");
+            meta::expects(f_min > 0 && f_min < f_max, "Expecting a valid frequency range");
+            meta::expects(f_max <= sample_rate / 2, "The maximum frequency must be below the Nyquist frequency");
+            meta::expects(bins_per_octave > 0, "Expecting at least one bin per octave");
+            meta::expects(gamma >= 0, "The bandwidth offset can not be negative");
+            meta::expects(hop_size > 0 && hop_size <= nfft_, "The hop size must be in the range [1, fft_size]");
+
+            const auto octaves = static_cast<value_type>(bins_per_octave) * std::log2(f_max / f_min);
+            const auto size    = static_cast<size_type>(std::floor(octaves)) + 1;
+
+            // The spectral kernels are the complex conjugate of the DFT of the temporal kernels, with the 1/L factor of
+            // the Parseval's theorem folded in. For a real frame X[L - j] = conj(X[j]), so the negative frequencies
+            // contribute conj(X[j] K[L - j]).
+            fft_engine<value_type> kernel_engine(nfft_);
+            std::vector<complex_type, complex_allocator> temporal(nfft_);
+            std::vector<complex_type, complex_allocator> spectral(nfft_);
+            std::vector<value_type, Allocator> window;
+            const auto bins = make_fft_size(nfft_);
+            for (size_type k = 0; k < size; ++k) {
+                const auto frequency = bin_frequency(k);
+                const auto length    = std::min(nfft_, kernel_length(sample_rate, frequency, bins_per_octave, gamma));
+                window.resize(length);
+                windowing::hamming(std::begin(window), std::end(window));
+
+                std::fill(std::begin(temporal), std::end(temporal), complex_type(0, 0));
+                const auto start = (nfft_ - length) / 2;
+                const auto omega = constants<value_type>::two_pi * frequency / sample_rate;
+                for (size_type n = 0; n < length; ++n) {
+                    temporal[start + n] =
+                        std::polar(window[n] / static_cast<value_type>(length), omega * static_cast<value_type>(n));
+                }
+                kernel_engine.dft(meta::data(temporal), meta::data(spectral));
+
+                const auto scaling = static_cast<value_type>(nfft_);
+                for (size_type j = 0; j < bins; ++j) {
+                    if (std::abs(spectral[j]) > threshold) {
+                        kernel_.push_back(j, std::conj(spectral[j]) / scaling);
+                    }
+                }
+                for (size_type j = 1; j < nfft_ - bins + 1; ++j) {
+                    if (std::abs(spectral[nfft_ - j]) > threshold) {
+                        mirror_.push_back(j, spectral[nfft_ - j] / scaling);
+                    }
+                }
+                kernel_.close_row();
+                mirror_.close_row();
+            }
+        }
+
+        /**
+         * @brief Returns the number of bins K of the transform.
+         */
+        inline size_type size() const noexcept {
+            return kernel_.rows();
+        }
+
+        /**
+         * @brief Returns the number of bins per octave.
+         */
+        inline size_type bins_per_octave() const noexcept {
+            return bins_per_octave_;
+        }
+
+        /**
+         * @brief Returns the number of samples of every frame, the size of the FFT.
+         */
+        inline size_type fft_size() const noexcept {
+            return nfft_;
+        }
+
+        /**
+         * @brief Returns the number of samples between the beginning of two consecutive frames of a stream.
+         */
+        inline size_type hop_size() const noexcept {
+            return hop_;
+        }
+
+        /**
+         * @brief Returns the number of non-zero values stored in the sparse kernel.
+         */
+        inline size_type nonzeros() const noexcept {
+            return kernel_.nonzeros() + mirror_.nonzeros();
+        }
+
+        /**
+         * @brief Returns the number of frames computed if the given number of samples is pushed.
+         *
+         * Use it to size the output matrix: it should have at least frames(N) * size() elements.
+         * @param samples Number of samples to be pushed.
+         * @returns Number of complete frames.
+         */
+        inline size_type frames(size_type samples) const noexcept {
+            const auto available = filled_ + samples;
+            return (available < nfft_) ? 0 : (available - nfft_) / hop_ + 1;
+        }
+
+        /**
+         * @brief Discards the buffered samples of the stream.
+         */
+        inline void reset() {
+            std::fill(std::begin(buffer_), std::end(buffer_), static_cast<value_type>(0));
+            filled_ = 0;
+        }
+
+        /**
+         * @brief Computes the center frequencies, in Hz, of the bins and stores the result in another range,
+         * beginning at d_first.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for size()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt frequencies(OutputIt d_first) const {
+            for (size_type k = 0, size = this->size(); k < size; ++k, ++d_first) {
+                *d_first = bin_frequency(k);
+            }
+            return d_first;
+        }
+
+        /**
+         * @brief Computes the transform of a single frame stored in the range [first, last) and stores the result in
+         * another range, beginning at d_first.
+         * @param first Input iterator defining the beginning of the frame.
+         * @param last Input iterator defining the ending of the frame, it is zero padded up to fft_size() samples.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for size()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt transform(InputIt first, InputIt last, OutputIt d_first) {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            meta::expects(count <= nfft_, "The frame can not be longer than the FFT size");
+            std::copy(first, last, std::begin(frame_));
+            std::fill(std::begin(frame_) + count, std::end(frame_), static_cast<value_type>(0));
+            return compute(d_first);
+        }
+
+        /**
+         * @brief Pushes the samples in the range [first, last) and computes the transform of every completed frame.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Pointer to the beginning of the output matrix, with room for frames(N) * size() elements.
+         * @returns Number of computed frames.
+         */
+        template <typename InputIt>
+        size_type process(InputIt first, InputIt last, complex_type* d_first) {
+            size_type computed{0};
+            while (first != last) {
+                const auto missing   = static_cast<std::ptrdiff_t>(nfft_ - filled_);
+                const auto available = std::distance(first, last);
+                const auto count     = std::min(missing, static_cast<std::ptrdiff_t>(available));
+                auto next            = std::next(first, count);
+                std::copy(first, next, std::begin(buffer_) + filled_);
+                filled_ += static_cast<size_type>(count);
+                first = next;
+
+                if (filled_ == nfft_) {
+                    std::copy(std::cbegin(buffer_), std::cend(buffer_), std::begin(frame_));
+                    d_first = compute(d_first);
+                    std::copy(std::begin(buffer_) + hop_, std::end(buffer_), std::begin(buffer_));
+                    filled_ = nfft_ - hop_;
+                    ++computed;
+                }
+            }
+            return computed;
+        }
+
+    private:
+        using complex_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<complex_type>;
+
+        // Number of samples of the temporal kernel of a bin: fs / (alpha f + gamma).
+        static size_type kernel_length(value_type sample_rate, value_type frequency, size_type bins_per_octave,
+                                       value_type gamma) {
+            const auto alpha = std::exp2(1 / static_cast<value_type>(bins_per_octave)) - 1;
+            return static_cast<size_type>(std::ceil(sample_rate / (alpha * frequency + gamma)));
+        }
+
+        inline value_type bin_frequency(size_type k) const {
+            return f_min_ * std::exp2(static_cast<value_type>(k) / static_cast<value_type>(bins_per_octave_));
+        }
+
+        template <typename OutputIt>
+        OutputIt compute(OutputIt d_first) {
+            engine_.dft(meta::data(frame_), meta::data(spectrum_));
+            const auto* spectrum = meta::data(spectrum_);
+            for (size_type k = 0, size = this->size(); k < size; ++k, ++d_first) {
+                *d_first = kernel_.dot(k, spectrum) + std::conj(mirror_.dot(k, spectrum));
+            }
+            return d_first;
+        }
+
+        value_type f_min_;
+        size_type bins_per_octave_;
+        size_type hop_;
+        size_type nfft_;
+        std::vector<value_type, Allocator> buffer_;
+        std::vector<value_type, Allocator> frame_;
+        std::vector<complex_type, complex_allocator> spectrum_;
+        fft_engine<value_type> engine_;
+        internal::csr_matrix<value_type, complex_allocator> kernel_;
+        internal::csr_matrix<value_type, complex_allocator> mirror_;
+        size_type filled_{0};
+    };
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_CONSTANT_Q_HPP
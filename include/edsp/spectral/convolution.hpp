@@ -24,10 +24,128 @@
 #define EDSP_CONVOLUTION_HPP
 
 #include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/meta/advance.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <vector>
 
 namespace edsp { inline namespace spectral {
 
+    /**
+     * @class convolver
+     * @brief This class computes the convolution of sequences of a fixed size, the reusable counterpart of %conv.
+     *
+     * The plans and the aligned scratch buffers are created in the constructor. When the class is created from a
+     * kernel, its spectrum is also computed once, so every call only costs a forward and an inverse transform. The
+     * calls do not allocate.
+     *
+     * @tparam T Floating point type.
+     * @tparam RAllocator Allocator type of the real buffers, defaults to aligned_allocator<T>.
+     * @tparam CAllocator Allocator type of the complex buffers, defaults to aligned_allocator<std::complex<T>>.
+     * @see conv
+     */
+    template <typename T, typename RAllocator = aligned_allocator<T>,
+              typename CAllocator = aligned_allocator<std::complex<T>>>
+    class convolver {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %convolver for sequences of the given size.
+         * @param size Number of samples of the sequences.
+         */
+        explicit convolver(size_type size) :
+            size_(size),
+            input_(2 * size, static_cast<value_type>(0)),
+            output_(2 * size),
+            spectrum_(make_fft_size(2 * size)),
+            operand_(make_fft_size(2 * size)),
+            engine_(2 * size) {
+            meta::expects(size > 0, "Not expecting empty input");
+        }
+
+        /**
+         * @brief Creates a %convolver for the fixed kernel stored in the range [first, last).
+         * @param first Input iterator defining the beginning of the kernel.
+         * @param last Input iterator defining the ending of the kernel. The size of the sequences is the size of the
+         * kernel.
+         */
+        template <typename InputIt>
+        convolver(InputIt first, InputIt last) : convolver(static_cast<size_type>(std::distance(first, last))) {
+            kernel_.resize(spectrum_.size());
+            transform(first, last, kernel_);
+        }
+
+        /**
+         * @brief Returns the number of samples of the sequences.
+         */
+        inline size_type size() const noexcept {
+            return size_;
+        }
+
+        /**
+         * @brief Computes the convolution between the range [first1, last1) and the range starting at first2, and
+         * stores the first size() samples of the result in another range, beginning at d_first.
+         * @param first1 Input iterator defining the beginning of the first input range.
+         * @param last1 Input iterator defining the ending of the first input range.
+         * @param first2 Input iterator defining the beginning of the second input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt process(InputIt first1, InputIt last1, InputIt first2, OutputIt d_first) {
+            transform(first2, meta::advance(first2, static_cast<std::ptrdiff_t>(size_)), operand_);
+            return convolve(first1, last1, operand_, d_first);
+        }
+
+        /**
+         * @brief Computes the convolution between the range [first, last) and the fixed kernel, and stores the first
+         * size() samples of the result in another range, beginning at d_first.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt process(InputIt first, InputIt last, OutputIt d_first) {
+            meta::expects(!kernel_.empty(), "The convolver has not been created from a kernel");
+            return convolve(first, last, kernel_, d_first);
+        }
+
+    private:
+        template <typename InputIt, typename Container>
+        void transform(InputIt first, InputIt last, Container& spectrum) {
+            meta::expects(static_cast<size_type>(std::distance(first, last)) == size_,
+                          "The size of the sequence does not match the size of the convolver");
+            std::copy(first, last, std::begin(input_));
+            engine_.dft(meta::data(input_), meta::data(spectrum));
+        }
+
+        template <typename InputIt, typename Container, typename OutputIt>
+        OutputIt convolve(InputIt first, InputIt last, const Container& other, OutputIt d_first) {
+            transform(first, last, spectrum_);
+            std::transform(std::cbegin(spectrum_), std::cend(spectrum_), std::cbegin(other), std::begin(spectrum_),
+                           std::multiplies<complex_type>());
+            engine_.idft(meta::data(spectrum_), meta::data(output_));
+            const auto factor = static_cast<value_type>(2 * size_);
+            return std::transform(std::cbegin(output_), std::cbegin(output_) + size_, d_first,
+                                  [factor](value_type val) { return val / factor; });
+        }
+
+        size_type size_;
+        std::vector<value_type, RAllocator> input_;
+        std::vector<value_type, RAllocator> output_;
+        std::vector<complex_type, CAllocator> spectrum_;
+        std::vector<complex_type, CAllocator> operand_;
+        std::vector<complex_type, CAllocator> kernel_;
+        fft_engine<value_type> engine_;
+    };
+
     /**
      * @brief Computes the convolution between the range [first1, last1) and the range [first2, last2), and stores the result in another range,
      * beginning at d_first.
@@ -44,34 +162,15 @@ namespace edsp { inline namespace spectral {
      * @param last1 Input iterator defining the ending of the first input range.
      * @param first2 Input iterator defining the beginning of the second input range.
      * @param d_first Output iterator defining the beginning of the destination range.
+     * @see convolver
      */
-    template <typename InputIt, typename OutputIt, typename RAllocator = std::allocator<meta::value_type_t<InputIt>>,
-              typename CAllocator = std::allocator<std::complex<meta::value_type_t<OutputIt>>>>
+    template <typename InputIt, typename OutputIt, typename RAllocator = aligned_allocator<meta::value_type_t<InputIt>>,
+              typename CAllocator = aligned_allocator<std::complex<meta::value_type_t<OutputIt>>>>
     inline void conv(InputIt first1, InputIt last1, InputIt first2, OutputIt d_first) {
         meta::expects(std::distance(first1, last1) > 0, "Not expecting empty input");
         using value_type = meta::value_type_t<InputIt>;
-        const auto size  = std::distance(first1, last1);
-        const auto nfft  = 2 * size;
-        fft_engine<value_type> fft_(nfft);
-        fft_engine<value_type> ifft_(nfft);
-
-        std::vector<value_type, RAllocator> temp_input1(nfft, static_cast<value_type>(0)),
-            temp_input2(nfft, static_cast<value_type>(0)), temp_output(nfft);
-        std::copy(first1, last1, std::begin(temp_input1));
-        std::copy(first2, meta::advance(first2, size), std::begin(temp_input2));
-
-        std::vector<std::complex<value_type>, CAllocator> fft_data1(make_fft_size(nfft));
-        std::vector<std::complex<value_type>, CAllocator> fft_data2(make_fft_size(nfft));
-
-        fft_.dft(meta::data(temp_input1), meta::data(fft_data1));
-        fft_.dft(meta::data(temp_input2), meta::data(fft_data2));
-
-        std::transform(std::cbegin(fft_data1), std::cend(fft_data1), std::cbegin(fft_data2), std::begin(fft_data1),
-                       std::multiplies<>());
-
-        ifft_.idft(meta::data(fft_data1), meta::data(temp_output));
-        ifft_.idft_scale(meta::data(temp_output));
-        std::copy(std::cbegin(temp_output), std::cbegin(temp_output) + size, d_first);
+        convolver<value_type, RAllocator, CAllocator> instance(static_cast<std::size_t>(std::distance(first1, last1)));
+        instance.process(first1, last1, first2, d_first);
     }
 
 }} // namespace edsp::spectral
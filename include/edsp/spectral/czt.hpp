@@ -0,0 +1,289 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: czt.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_CZT_HPP
+#define EDSP_CZT_HPP
+
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/math/numeric.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/data.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    namespace internal {
+
+        // Computes z^x with the principal logarithm. The exponent is evaluated in double precision, as it grows with
+        // the square of the index.
+        template <typename T>
+        inline std::complex<T> complex_pow(const std::complex<T>& z, double x) {
+            const auto magnitude = std::log(static_cast<double>(std::abs(z)));
+            const auto phase     = static_cast<double>(std::arg(z));
+            return std::complex<T>(std::polar(std::exp(x * magnitude), x * phase));
+        }
+
+    } // namespace internal
+
+    /**
+     * @class chirp_z
+     * @brief This class computes the Chirp Z-Transform (CZT) of sequences of a fixed size, evaluating the
+     * z-transform at M points along a spiral of the z-plane:
+     *
+     * \f[
+     *  X_k = \sum_{n=0}^{N-1} x[n] A^{-n} W^{nk}, \qquad k = 0, \ldots, M-1
+     * \f]
+     *
+     * The transform is computed with the Bluestein algorithm, as a convolution of size L >= N + M - 1. The chirps and
+     * the spectrum of the convolution kernel are computed in the constructor, so every call only costs a forward and
+     * an inverse FFT of size L, and does not allocate.
+     *
+     * When |W| is not one, the chirps grow as |W|^(n^2/2), so the spirals should stay close to the unit circle to
+     * keep the transform accurate.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the complex buffers, defaults to aligned_allocator<std::complex<T>>.
+     * @see zoom_fft
+     */
+    template <typename T, typename Allocator = aligned_allocator<std::complex<T>>>
+    class chirp_z {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %chirp_z transform.
+         * @param size Number of samples N of the input sequences.
+         * @param points Number of points M of the transform.
+         * @param w Ratio W between two consecutive points of the spiral.
+         * @param a Starting point A of the spiral.
+         */
+        chirp_z(size_type size, size_type points, const complex_type& w, const complex_type& a = complex_type(1, 0)) :
+            nfft_(math::next_power_two(size + points - 1)),
+            pre_(size),
+            post_(points),
+            kernel_(nfft_),
+            buffer_(nfft_),
+            engine_(nfft_) {
+            meta::expects(size > 0, "Not expecting empty input");
+            meta::expects(points > 0, "Not expecting empty output");
+            meta::expects(w != complex_type(0, 0) && a != complex_type(0, 0), "The spiral can not cross the origin");
+
+            const auto half = [](size_type n) { return static_cast<double>(n) * static_cast<double>(n) / 2; };
+            for (size_type n = 0; n < size; ++n) {
+                pre_[n] = internal::complex_pow(a, -static_cast<double>(n)) * internal::complex_pow(w, half(n));
+            }
+            for (size_type k = 0; k < points; ++k) {
+                post_[k] = internal::complex_pow(w, half(k));
+            }
+
+            // The kernel W^(-m^2/2), for m in (-N, M), is stored circularly and transformed once. The scaling of the
+            // inverse transform is folded in.
+            std::fill(std::begin(buffer_), std::end(buffer_), complex_type(0, 0));
+            const auto scaling = static_cast<value_type>(nfft_);
+            for (size_type m = 0; m < points; ++m) {
+                buffer_[m] = internal::complex_pow(w, -half(m)) / scaling;
+            }
+            for (size_type n = 1; n < size; ++n) {
+                buffer_[nfft_ - n] = internal::complex_pow(w, -half(n)) / scaling;
+            }
+            engine_.dft(meta::data(buffer_), meta::data(kernel_));
+        }
+
+        /**
+         * @brief Returns the number of samples N of the input sequences.
+         */
+        inline size_type size() const noexcept {
+            return pre_.size();
+        }
+
+        /**
+         * @brief Returns the number of points M of the transform.
+         */
+        inline size_type points() const noexcept {
+            return post_.size();
+        }
+
+        /**
+         * @brief Returns the size of the FFTs used to compute the transform.
+         */
+        inline size_type fft_size() const noexcept {
+            return nfft_;
+        }
+
+        /**
+         * @brief Computes the transform of the range [first, last) and stores the result in another range, beginning
+         * at d_first.
+         * @param first Input iterator defining the beginning of the input range, real or complex.
+         * @param last Input iterator defining the ending of the input range, it should have size() samples.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for points()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt process(InputIt first, InputIt last, OutputIt d_first) {
+            meta::expects(static_cast<size_type>(std::distance(first, last)) == pre_.size(),
+                          "The size of the sequence does not match the size of the transform");
+            for (size_type n = 0, size = pre_.size(); n < size; ++n, ++first) {
+                buffer_[n] = complex_type(*first) * pre_[n];
+            }
+            std::fill(std::begin(buffer_) + pre_.size(), std::end(buffer_), complex_type(0, 0));
+
+            engine_.dft(meta::data(buffer_), meta::data(buffer_));
+            std::transform(std::cbegin(buffer_), std::cend(buffer_), std::cbegin(kernel_), std::begin(buffer_),
+                           std::multiplies<complex_type>());
+            engine_.idft(meta::data(buffer_), meta::data(buffer_));
+
+            for (size_type k = 0, points = post_.size(); k < points; ++k, ++d_first) {
+                *d_first = buffer_[k] * post_[k];
+            }
+            return d_first;
+        }
+
+    private:
+        size_type nfft_;
+        std::vector<complex_type, Allocator> pre_;
+        std::vector<complex_type, Allocator> post_;
+        std::vector<complex_type, Allocator> kernel_;
+        std::vector<complex_type, Allocator> buffer_;
+        fft_engine<value_type> engine_;
+    };
+
+    /**
+     * @class zoom_fft
+     * @brief This class computes the spectrum of sequences of a fixed size at M frequencies equally spaced over an
+     * arbitrary band [f_start, f_stop], both included.
+     *
+     * It is a %chirp_z transform evaluated along the unit circle, equivalent to a zero-padded DFT restricted to the
+     * band, at a fraction of its cost when the band is narrow.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the complex buffers, defaults to aligned_allocator<std::complex<T>>.
+     * @see chirp_z
+     */
+    template <typename T, typename Allocator = aligned_allocator<std::complex<T>>>
+    class zoom_fft {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %zoom_fft.
+         * @param size Number of samples N of the input sequences.
+         * @param points Number of frequencies M.
+         * @param f_start First frequency of the band, in Hz.
+         * @param f_stop Last frequency of the band, in Hz.
+         * @param sample_rate Sampling frequency in Hz.
+         */
+        zoom_fft(size_type size, size_type points, value_type f_start, value_type f_stop, value_type sample_rate) :
+            f_start_(f_start),
+            step_((points > 1) ? (f_stop - f_start) / static_cast<value_type>(points - 1) : 0),
+            transform_(size, points,
+                       std::polar(static_cast<value_type>(1), -constants<value_type>::two_pi * step_ / sample_rate),
+                       std::polar(static_cast<value_type>(1), constants<value_type>::two_pi * f_start / sample_rate)) {
+            meta::expects(sample_rate > 0, "The sample rate must be positive");
+        }
+
+        /**
+         * @brief Returns the number of samples N of the input sequences.
+         */
+        inline size_type size() const noexcept {
+            return transform_.size();
+        }
+
+        /**
+         * @brief Returns the number of frequencies M.
+         */
+        inline size_type points() const noexcept {
+            return transform_.points();
+        }
+
+        /**
+         * @brief Computes the frequencies, in Hz, of the points of the spectrum and stores the result in another
+         * range, beginning at d_first.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for points()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt frequencies(OutputIt d_first) const {
+            for (size_type k = 0, points = transform_.points(); k < points; ++k, ++d_first) {
+                *d_first = f_start_ + step_ * static_cast<value_type>(k);
+            }
+            return d_first;
+        }
+
+        /**
+         * @brief Computes the spectrum of the range [first, last) over the band and stores the result in another
+         * range, beginning at d_first.
+         * @param first Input iterator defining the beginning of the input range, real or complex.
+         * @param last Input iterator defining the ending of the input range, it should have size() samples.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for points()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt process(InputIt first, InputIt last, OutputIt d_first) {
+            return transform_.process(first, last, d_first);
+        }
+
+    private:
+        value_type f_start_;
+        value_type step_;
+        chirp_z<value_type, Allocator> transform_;
+    };
+
+    /**
+     * @brief Computes the Chirp Z-Transform of the range [first, last) at M points and stores the result in another
+     * range, beginning at d_first.
+     *
+     * \f[
+     *  X_k = \sum_{n=0}^{N-1} x[n] A^{-n} W^{nk}, \qquad k = 0, \ldots, M-1
+     * \f]
+     *
+     * @param first Input iterator defining the beginning of the input range.
+     * @param last Input iterator defining the ending of the input range.
+     * @param d_first Output iterator defining the beginning of the destination range.
+     * @param points Number of points M of the transform.
+     * @param w Ratio W between two consecutive points of the spiral.
+     * @param a Starting point A of the spiral.
+     * @see chirp_z
+     */
+    template <typename InputIt, typename OutputIt, typename T>
+    inline void czt(InputIt first, InputIt last, OutputIt d_first, std::size_t points, const std::complex<T>& w,
+                    const std::complex<T>& a = std::complex<T>(1, 0)) {
+        chirp_z<T> transform(static_cast<std::size_t>(std::distance(first, last)), points, w, a);
+        transform.process(first, last, d_first);
+    }
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_CZT_HPP
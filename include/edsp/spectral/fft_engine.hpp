@@ -24,6 +24,10 @@
 #define EDSP_FFT_HPP
 
 #include <edsp/spectral/internal/fft_impl.hpp>
+#include <edsp/spectral/plan_cache.hpp>
+#include <edsp/spectral/split_complex.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <string>
 
 namespace edsp { inline namespace spectral {
 
@@ -49,7 +53,12 @@ namespace edsp { inline namespace spectral {
      * @brief This class contains an instance of an FFT engine. Use this class to perform
      * an FFT internally in any algorithm and only for performance reason. There are wrappers
      * around this class to perform basic operations.
+     *
+     * The plans are created lazily and shared with other engines through the process-wide %plan_cache, so creating
+     * several engines of the same size only pays the planning cost once. Buffers satisfying alignment() (e.g. those
+     * allocated with aligned_allocator) are transformed with plans specialized for aligned data.
      * @tparam T Floating point type.
+     * @see plan_cache
      */
     template <typename T>
     class fft_engine {
@@ -62,15 +71,64 @@ namespace edsp { inline namespace spectral {
 
         /**
          * @brief Creates a FFT engine of the given size
+         *
+         * Very large transforms (millions of samples) can be split between several threads. Threading is opt-in: it
+         * requires the FFTW backend built with USE_LIBFFTW_THREADS, otherwise the transforms are single-threaded.
          * @param nfft Number of samples of the FFT
+         * @param rigor Effort spent by the backend searching for the fastest plans.
+         * @param threads Number of threads used to compute every transform.
          */
-        explicit fft_engine(size_type nfft) : impl_(nfft) {}
+        explicit fft_engine(size_type nfft, planning_rigor rigor = planning_rigor::Estimate, size_type threads = 1) :
+            impl_(cast(nfft), rigor, cast(threads)) {}
 
         /**
          * @brief Default destructor
          */
         ~fft_engine() = default;
 
+        /**
+         * @brief Returns the alignment, in bytes, of the buffers the backend transforms with its fastest code paths.
+         *
+         * Buffers allocated with aligned_allocator (or aligned_buffer) satisfy it.
+         * @returns Alignment in bytes.
+         */
+        static constexpr size_type alignment() noexcept {
+            return internal::fft_impl<T>::alignment;
+        }
+
+        /**
+         * @brief Checks if a buffer satisfies the alignment expected by the backend.
+         * @param p Pointer to the beginning of the buffer.
+         * @returns true if the buffer is aligned, false otherwise.
+         */
+        static bool is_aligned(const void* p) noexcept {
+            return types::is_aligned(p, alignment());
+        }
+
+        /**
+         * @brief Returns the rigor used to create the plans of this engine.
+         * @returns Planning rigor.
+         */
+        inline planning_rigor rigor() const noexcept {
+            return impl_.rigor();
+        }
+
+        /**
+         * @brief Returns the number of threads used to compute every transform.
+         * @returns Number of threads, 1 if the backend is single-threaded.
+         */
+        inline size_type threads() const noexcept {
+            return static_cast<size_type>(impl_.threads());
+        }
+
+        /**
+         * @brief Returns the number of samples of the transforms computed by this engine.
+         * @returns Size of the FFT.
+         */
+        inline size_type size() const noexcept {
+            return static_cast<size_type>(impl_.size());
+        }
+
         /**
          * @brief Performs a Complex-to-Complex FFT
          * @note The buffer size should be the engine's size.
@@ -114,6 +172,45 @@ namespace edsp { inline namespace spectral {
             impl_.idft(src, dst);
         }
 
+        /**
+         * @brief Performs a Complex-to-Complex FFT over split-complex buffers.
+         * @note The views should store size() samples. Views of a split_complex_buffer of that size are transformed
+         * directly, other layouts may be copied through an internal buffer of the engine.
+         * @param src View of the input samples.
+         * @param dst View of the buffers storing the computed spectral samples.
+         * @see split_complex_view
+         */
+        inline void dft(const split_complex_view<const value_type>& src, const split_complex_view<value_type>& dst) {
+            impl_.dft(src, dst);
+        }
+
+        /**
+         * @brief Performs a Complex-to-Complex IFFT over split-complex buffers.
+         * @param src View of the spectral samples.
+         * @param dst View of the buffers storing the transformed samples.
+         */
+        inline void idft(const split_complex_view<const value_type>& src, const split_complex_view<value_type>& dst) {
+            impl_.idft(src, dst);
+        }
+
+        /**
+         * @brief Performs a Real-to-Complex-Hermitian FFT storing the result in split-complex buffers.
+         * @param src Buffer storing size() purely real numbers.
+         * @param dst View of the buffers storing the make_fft_size(size()) computed spectral samples.
+         */
+        inline void dft(const value_type* src, const split_complex_view<value_type>& dst) {
+            impl_.dft(src, dst);
+        }
+
+        /**
+         * @brief Performs a Complex-Hermitian-to-Real IFFT from split-complex buffers.
+         * @param src View of the make_fft_size(size()) spectral samples.
+         * @param dst Buffer storing the size() transformed samples.
+         */
+        inline void idft(const split_complex_view<const value_type>& src, value_type* dst) {
+            impl_.idft(src, dst);
+        }
+
         /**
          * @brief Performs a Discrete Hartley Transform (DHT)
          * @param src Buffer storing the input samples.
@@ -141,6 +238,118 @@ namespace edsp { inline namespace spectral {
             impl_.idct(src, dst);
         }
 
+        /**
+         * @brief Performs several Complex-to-Complex FFTs with a single call.
+         *
+         * The k-th sample of the i-th transform is read from src[i * idist + k * istride] and stored in
+         * dst[i * odist + k * ostride], so frames stored one after the other, interleaved channels or the columns of
+         * a matrix can be transformed without copying them.
+         * @param src Buffer storing the input samples.
+         * @param dst Buffer storing the computed spectral samples.
+         * @param howmany Number of transforms.
+         * @param istride Distance between two consecutive samples of an input frame.
+         * @param idist Distance between the first samples of two consecutive input frames.
+         * @param ostride Distance between two consecutive samples of an output frame.
+         * @param odist Distance between the first samples of two consecutive output frames.
+         */
+        inline void dft_many(const complex_type* src, complex_type* dst, size_type howmany, size_type istride,
+                             size_type idist, size_type ostride, size_type odist) {
+            impl_.dft_many(src, dst, cast(howmany), cast(istride), cast(idist), cast(ostride), cast(odist));
+        }
+
+        /**
+         * @brief Performs several Complex-to-Complex FFTs over contiguous frames of size(), stored one after the other.
+         * @param src Buffer storing the input samples.
+         * @param dst Buffer storing the computed spectral samples.
+         * @param howmany Number of transforms.
+         */
+        inline void dft_many(const complex_type* src, complex_type* dst, size_type howmany) {
+            dft_many(src, dst, howmany, 1, size(), 1, size());
+        }
+
+        /**
+         * @brief Performs several Complex-to-Complex IFFTs with a single call.
+         * @param src Buffer storing the computed spectral samples.
+         * @param dst Buffer storing the transformed samples.
+         * @param howmany Number of transforms.
+         * @param istride Distance between two consecutive samples of an input frame.
+         * @param idist Distance between the first samples of two consecutive input frames.
+         * @param ostride Distance between two consecutive samples of an output frame.
+         * @param odist Distance between the first samples of two consecutive output frames.
+         * @see dft_many
+         */
+        inline void idft_many(const complex_type* src, complex_type* dst, size_type howmany, size_type istride,
+                              size_type idist, size_type ostride, size_type odist) {
+            impl_.idft_many(src, dst, cast(howmany), cast(istride), cast(idist), cast(ostride), cast(odist));
+        }
+
+        /**
+         * @brief Performs several Complex-to-Complex IFFTs over contiguous frames of size(), stored one after the
+         * other.
+         * @param src Buffer storing the computed spectral samples.
+         * @param dst Buffer storing the transformed samples.
+         * @param howmany Number of transforms.
+         */
+        inline void idft_many(const complex_type* src, complex_type* dst, size_type howmany) {
+            idft_many(src, dst, howmany, 1, size(), 1, size());
+        }
+
+        /**
+         * @brief Performs several Real-to-Complex-Hermitian FFTs with a single call.
+         *
+         * Every input frame has size() real samples and every output frame make_fft_size(size()) complex samples.
+         * @param src Buffer storing purely real numbers.
+         * @param dst Buffer storing the computed spectral samples.
+         * @param howmany Number of transforms.
+         * @param istride Distance between two consecutive samples of an input frame.
+         * @param idist Distance between the first samples of two consecutive input frames.
+         * @param ostride Distance between two consecutive samples of an output frame.
+         * @param odist Distance between the first samples of two consecutive output frames.
+         * @see dft_many
+         */
+        inline void dft_many(const value_type* src, complex_type* dst, size_type howmany, size_type istride,
+                             size_type idist, size_type ostride, size_type odist) {
+            impl_.dft_many(src, dst, cast(howmany), cast(istride), cast(idist), cast(ostride), cast(odist));
+        }
+
+        /**
+         * @brief Performs several Real-to-Complex-Hermitian FFTs over contiguous frames, stored one after the other.
+         * @param src Buffer storing purely real numbers.
+         * @param dst Buffer storing the computed spectral samples.
+         * @param howmany Number of transforms.
+         */
+        inline void dft_many(const value_type* src, complex_type* dst, size_type howmany) {
+            dft_many(src, dst, howmany, 1, size(), 1, make_fft_size(size()));
+        }
+
+        /**
+         * @brief Performs several Complex-Hermitian-to-Real IFFTs with a single call.
+         *
+         * Every input frame has make_fft_size(size()) complex samples and every output frame size() real samples.
+         * @param src Buffer storing the computed spectral samples.
+         * @param dst Buffer storing the transformed samples.
+         * @param howmany Number of transforms.
+         * @param istride Distance between two consecutive samples of an input frame.
+         * @param idist Distance between the first samples of two consecutive input frames.
+         * @param ostride Distance between two consecutive samples of an output frame.
+         * @param odist Distance between the first samples of two consecutive output frames.
+         * @see dft_many
+         */
+        inline void idft_many(const complex_type* src, value_type* dst, size_type howmany, size_type istride,
+                              size_type idist, size_type ostride, size_type odist) {
+            impl_.idft_many(src, dst, cast(howmany), cast(istride), cast(idist), cast(ostride), cast(odist));
+        }
+
+        /**
+         * @brief Performs several Complex-Hermitian-to-Real IFFTs over contiguous frames, stored one after the other.
+         * @param src Buffer storing the computed spectral samples.
+         * @param dst Buffer storing the transformed samples.
+         * @param howmany Number of transforms.
+         */
+        inline void idft_many(const complex_type* src, value_type* dst, size_type howmany) {
+            idft_many(src, dst, howmany, 1, make_fft_size(size()), 1, size());
+        }
+
         /**
          * @brief Scales the computed IFFT to match the original input
          * @param dst Buffer containing the samples to be scaled
@@ -159,9 +368,69 @@ namespace edsp { inline namespace spectral {
         }
 
     private:
+        using impl_size_type = typename internal::fft_impl<T>::size_type;
+
+        static impl_size_type cast(size_type value) noexcept {
+            return static_cast<impl_size_type>(value);
+        }
+
         internal::fft_impl<T> impl_;
     };
 
+    /**
+     * @brief This class manages the wisdom of the FFT backend.
+     *
+     * The wisdom stores the results of the rigorous planning stages (see planning_rigor). Long-running processes can
+     * pay the planning cost once per deployment: export the wisdom after planning and import it at startup, so the
+     * following plans are created instantly. Backends without wisdom support ignore these operations.
+     *
+     * @tparam T Floating point type.
+     */
+    template <typename T>
+    struct fft_wisdom {
+        /**
+         * @brief Imports the wisdom stored in a file.
+         * @param filename Path to the file.
+         * @returns true if the wisdom was imported, false otherwise.
+         */
+        static bool import_from_file(const std::string& filename) {
+            return internal::fft_wisdom_impl<T>::import_from_file(filename);
+        }
+
+        /**
+         * @brief Exports the accumulated wisdom to a file.
+         * @param filename Path to the file.
+         * @returns true if the wisdom was exported, false otherwise.
+         */
+        static bool export_to_file(const std::string& filename) {
+            return internal::fft_wisdom_impl<T>::export_to_file(filename);
+        }
+
+        /**
+         * @brief Imports the wisdom stored in a string.
+         * @param wisdom String with the wisdom, as generated by export_to_string.
+         * @returns true if the wisdom was imported, false otherwise.
+         */
+        static bool import_from_string(const std::string& wisdom) {
+            return internal::fft_wisdom_impl<T>::import_from_string(wisdom);
+        }
+
+        /**
+         * @brief Exports the accumulated wisdom to a string.
+         * @returns String with the wisdom, empty if not available.
+         */
+        static std::string export_to_string() {
+            return internal::fft_wisdom_impl<T>::export_to_string();
+        }
+
+        /**
+         * @brief Discards the accumulated wisdom.
+         */
+        static void forget() {
+            internal::fft_wisdom_impl<T>::forget();
+        }
+    };
+
 }} // namespace edsp::spectral
 
 #endif //EDSP_FFT_HPP
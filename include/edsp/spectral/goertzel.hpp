@@ -0,0 +1,173 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: goertzel.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_GOERTZEL_HPP
+#define EDSP_GOERTZEL_HPP
+
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/data.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iterator>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    /**
+     * @class goertzel_bank
+     * @brief This class evaluates the Discrete-Time Fourier Transform of a block of samples at a few arbitrary
+     * frequencies with the Goertzel algorithm.
+     *
+     * Every frequency is tracked by a second order resonator:
+     *
+     * \f[
+     *  s[n] = x[n] + 2 \cos(\omega_k) s[n-1] - s[n-2]
+     * \f]
+     *
+     * so every pushed sample costs a multiplication and two additions per frequency, instead of a full FFT per block.
+     * The states of all the resonators are stored in contiguous arrays and updated together, so the update of the
+     * bank is vectorized by the compiler.
+     *
+     * The transform is evaluated over the samples pushed since the last call to reset().
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the internal buffers, defaults to aligned_allocator<T>.
+     * @see sliding_dft
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class goertzel_bank {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %goertzel_bank tracking the frequencies stored in the range [first, last).
+         * @param first Input iterator defining the beginning of the frequencies, in Hz.
+         * @param last Input iterator defining the ending of the frequencies, in Hz.
+         * @param sample_rate Sampling frequency in Hz.
+         */
+        template <typename InputIt>
+        goertzel_bank(InputIt first, InputIt last, value_type sample_rate) :
+            omega_(first, last),
+            coefficients_(omega_.size()),
+            s1_(omega_.size(), static_cast<value_type>(0)),
+            s2_(omega_.size(), static_cast<value_type>(0)) {
+            meta::expects(sample_rate > 0, "The sample rate must be positive");
+            for (size_type k = 0; k < omega_.size(); ++k) {
+                omega_[k]        = constants<value_type>::two_pi * omega_[k] / sample_rate;
+                coefficients_[k] = 2 * std::cos(omega_[k]);
+            }
+        }
+
+        /**
+         * @brief Returns the number of tracked frequencies.
+         */
+        inline size_type size() const noexcept {
+            return omega_.size();
+        }
+
+        /**
+         * @brief Returns the number of samples pushed since the last reset.
+         */
+        inline size_type count() const noexcept {
+            return count_;
+        }
+
+        /**
+         * @brief Resets the resonators, to start the evaluation of a new block.
+         */
+        inline void reset() {
+            std::fill(std::begin(s1_), std::end(s1_), static_cast<value_type>(0));
+            std::fill(std::begin(s2_), std::end(s2_), static_cast<value_type>(0));
+            count_ = 0;
+        }
+
+        /**
+         * @brief Pushes the samples in the range [first, last) into all the resonators.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         */
+        template <typename InputIt>
+        void update(InputIt first, InputIt last) {
+            const auto size = omega_.size();
+            auto* s1        = meta::data(s1_);
+            auto* s2        = meta::data(s2_);
+            const auto* c   = meta::data(coefficients_);
+            for (; first != last; ++first, ++count_) {
+                const auto sample = static_cast<value_type>(*first);
+                for (size_type k = 0; k < size; ++k) {
+                    const auto s0 = sample + c[k] * s1[k] - s2[k];
+                    s2[k]         = s1[k];
+                    s1[k]         = s0;
+                }
+            }
+        }
+
+        /**
+         * @brief Computes the power of the tracked frequencies and stores the result in another range, beginning at
+         * d_first.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for size()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt power(OutputIt d_first) const {
+            for (size_type k = 0, size = omega_.size(); k < size; ++k, ++d_first) {
+                *d_first = s1_[k] * s1_[k] + s2_[k] * s2_[k] - coefficients_[k] * s1_[k] * s2_[k];
+            }
+            return d_first;
+        }
+
+        /**
+         * @brief Computes the complex value of the transform at the tracked frequencies and stores the result in
+         * another range, beginning at d_first.
+         *
+         * The phase is referred to the first sample of the block, as in the DFT.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for size()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt dft(OutputIt d_first) const {
+            const auto last = static_cast<value_type>(count_ == 0 ? 0 : count_ - 1);
+            for (size_type k = 0, size = omega_.size(); k < size; ++k, ++d_first) {
+                const auto y = complex_type(s1_[k], 0) - std::polar(s2_[k], -omega_[k]);
+                *d_first     = y * std::polar(static_cast<value_type>(1), -omega_[k] * last);
+            }
+            return d_first;
+        }
+
+    private:
+        std::vector<value_type, Allocator> omega_;
+        std::vector<value_type, Allocator> coefficients_;
+        std::vector<value_type, Allocator> s1_;
+        std::vector<value_type, Allocator> s2_;
+        size_type count_{0};
+    };
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_GOERTZEL_HPP
@@ -23,12 +23,118 @@
 #define EDSP_HILBERT_HPP
 
 #include <edsp/spectral/fft_engine.hpp>
-#include <edsp/converter/real2complex.hpp>
-#include <edsp/math/numeric.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <vector>
 
 namespace edsp { inline namespace spectral {
 
+    /**
+     * @class hilbert_transformer
+     * @brief This class computes the Discrete-Time analytic signal of real sequences of a fixed size.
+     *
+     * As the input is real, only the Hilbert transform has to be computed: it is obtained with a Real-to-Complex
+     * transform, a rotation of -90 degrees of the positive frequencies and a Complex-to-Real transform, both of half
+     * the cost of a complex transform. The real part of the analytic signal is the input itself.
+     *
+     * The plans and the scratch buffers are created in the constructor, so the transformer can be reused without
+     * allocating.
+     *
+     * @tparam T Floating point type.
+     * @tparam RAllocator Allocator type of the real buffers, defaults to aligned_allocator<T>.
+     * @tparam CAllocator Allocator type of the complex buffers, defaults to aligned_allocator<std::complex<T>>.
+     * @see hilbert
+     */
+    template <typename T, typename RAllocator = aligned_allocator<T>,
+              typename CAllocator = aligned_allocator<std::complex<T>>>
+    class hilbert_transformer {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %hilbert_transformer for sequences of the given size.
+         * @param size Number of samples of the sequences.
+         */
+        explicit hilbert_transformer(size_type size) :
+            input_(size),
+            output_(size),
+            spectrum_(make_fft_size(size)),
+            engine_(size) {
+            meta::expects(size > 0, "Not expecting empty sequences");
+        }
+
+        /**
+         * @brief Returns the number of samples of the sequences.
+         */
+        inline size_type size() const noexcept {
+            return input_.size();
+        }
+
+        /**
+         * @brief Computes the analytic signal of the range [first, last) and stores the result in another range,
+         * beginning at d_first.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range, it should have size() samples.
+         * @param d_first Output iterator defining the beginning of the complex destination range.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt process(InputIt first, InputIt last, OutputIt d_first) {
+            transform(first, last);
+            for (size_type i = 0, size = input_.size(); i < size; ++i, ++d_first) {
+                *d_first = complex_type(input_[i], output_[i]);
+            }
+            return d_first;
+        }
+
+        /**
+         * @brief Computes the Hilbert transform of the range [first, last), the imaginary part of its analytic
+         * signal, and stores the result in another range, beginning at d_first.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range, it should have size() samples.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt quadrature(InputIt first, InputIt last, OutputIt d_first) {
+            transform(first, last);
+            return std::copy(std::cbegin(output_), std::cend(output_), d_first);
+        }
+
+    private:
+        template <typename InputIt>
+        void transform(InputIt first, InputIt last) {
+            meta::expects(static_cast<size_type>(std::distance(first, last)) == input_.size(),
+                          "The size of the sequence does not match the size of the transformer");
+            std::copy(first, last, std::begin(input_));
+            engine_.dft(meta::data(input_), meta::data(spectrum_));
+
+            // Multiplies the positive frequencies by -j, the DC and the Nyquist components are discarded. The
+            // scaling of the inverse transform is folded in.
+            const auto size    = input_.size();
+            const auto scaling = static_cast<value_type>(1) / static_cast<value_type>(size);
+            spectrum_.front()  = complex_type(0, 0);
+            for (size_type i = 1, bins = spectrum_.size(); i < bins; ++i) {
+                const auto bin = spectrum_[i];
+                spectrum_[i]   = complex_type(bin.imag() * scaling, -bin.real() * scaling);
+            }
+            if (size % 2 == 0) {
+                spectrum_.back() = complex_type(0, 0);
+            }
+            engine_.idft(meta::data(spectrum_), meta::data(output_));
+        }
+
+        std::vector<value_type, RAllocator> input_;
+        std::vector<value_type, RAllocator> output_;
+        std::vector<complex_type, CAllocator> spectrum_;
+        fft_engine<value_type> engine_;
+    };
+
     /**
      * @brief Computes the Discrete-Time analytic signal using Hilbert transform of the range [first, last)
      * and stores the result in another range, beginning at d_first.
@@ -45,35 +151,20 @@ namespace edsp { inline namespace spectral {
      * @param first Input iterator defining the beginning of the input range.
      * @param last Input iterator defining the ending of the input range.
      * @param d_first Output iterator defining the beginning of the destination range.
-     * @see complex_idft
+     * @see hilbert_transformer
      */
     template <typename InputIt, typename OutputIt,
-              typename Allocator = std::allocator<std::complex<meta::value_type_t<InputIt>>>>
+              typename Allocator = aligned_allocator<std::complex<meta::value_type_t<InputIt>>>>
     inline void hilbert(InputIt first, InputIt last, OutputIt d_first) {
-        // TODO: add the static assertion, the input should be a complex array
-        using value_type = meta::value_type_t<InputIt>;
-        const auto nfft  = static_cast<typename fft_engine<value_type>::size_type>(std::distance(first, last));
-
-        std::vector<std::complex<value_type>, Allocator> input_data(nfft);
-        std::vector<std::complex<value_type>, Allocator> complex_data(nfft);
-        edsp::real2complex(first, last, std::begin(input_data));
-
-        fft_engine<value_type> fft(nfft);
-        fft.dft(meta::data(input_data), meta::data(complex_data));
-
-        const auto limit_1 = math::is_even(nfft) ? nfft / 2 : (nfft + 1) / 2;
-        const auto limit_2 = math::is_even(nfft) ? limit_1 + 1 : limit_1;
-        for (auto i = 1ul; i < limit_1; ++i) {
-            complex_data[i] *= 2;
-        }
-
-        for (auto i = limit_2; i < nfft; ++i) {
-            complex_data[i] = std::complex<value_type>(0, 0);
+        using value_type     = meta::value_type_t<InputIt>;
+        using real_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+        if (first == last) {
+            return;
         }
 
-        fft_engine<value_type> ifft(nfft);
-        ifft.idft(meta::data(complex_data), &(*d_first));
-        ifft.idft_scale(&(*d_first));
+        hilbert_transformer<value_type, real_allocator, Allocator> transformer(
+            static_cast<std::size_t>(std::distance(first, last)));
+        transformer.process(first, last, d_first);
     }
 
 }} // namespace edsp::spectral
@@ -34,9 +34,15 @@ namespace edsp { inline namespace spectral { namespace internal {
 #if defined(USE_LIBFFTW)
     template <typename T>
     using fft_impl = spectral::fftw_impl<T>;
+
+    template <typename T>
+    using fft_wisdom_impl = spectral::fftw_wisdom<T>;
 #elif defined(USE_LIBPFFFT)
     template <typename T>
     using fft_impl = spectral::pffft_impl<T>;
+
+    template <typename T>
+    using fft_wisdom_impl = spectral::pffft_wisdom<T>;
 #elif defined(USE_LIBACCELERATE)
 #    error "Not implemented yet"
 #else
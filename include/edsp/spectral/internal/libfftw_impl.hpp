@@ -28,10 +28,18 @@
 #include <edsp/meta/iterator.hpp>
 #include <edsp/meta/expects.hpp>
 #include <edsp/meta/data.hpp>
+#include <edsp/spectral/plan_cache.hpp>
+#include <edsp/spectral/split_complex.hpp>
+#include <edsp/types/aligned_allocator.hpp>
 
 #include <complex>
 #include <fftw3.h>
 #include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace edsp { inline namespace spectral {
     namespace internal {
@@ -47,78 +55,503 @@ namespace edsp { inline namespace spectral {
         inline fftw_complex* fftw_cast(const std::complex<double>* p) {
             return const_cast<fftw_complex*>(reinterpret_cast<const fftw_complex*>(p));
         }
+
+        template <typename T>
+        struct fftw_api {};
+
+        template <>
+        struct fftw_api<float> {
+            using plan_type    = ::fftwf_plan;
+            using complex_type = ::fftwf_complex;
+
+            static plan_type plan_dft_1d(int n, complex_type* in, complex_type* out, int sign, unsigned flags) {
+                return fftwf_plan_dft_1d(n, in, out, sign, flags);
+            }
+
+            static plan_type plan_dft_r2c_1d(int n, float* in, complex_type* out, unsigned flags) {
+                return fftwf_plan_dft_r2c_1d(n, in, out, flags);
+            }
+
+            static plan_type plan_dft_c2r_1d(int n, complex_type* in, float* out, unsigned flags) {
+                return fftwf_plan_dft_c2r_1d(n, in, out, flags);
+            }
+
+            static plan_type plan_r2r_1d(int n, float* in, float* out, fftwf_r2r_kind kind, unsigned flags) {
+                return fftwf_plan_r2r_1d(n, in, out, kind, flags);
+            }
+
+            static plan_type plan_many_dft(int n, int howmany, complex_type* in, int istride, int idist,
+                                           complex_type* out, int ostride, int odist, int sign, unsigned flags) {
+                return fftwf_plan_many_dft(1, &n, howmany, in, nullptr, istride, idist, out, nullptr, ostride, odist,
+                                         sign, flags);
+            }
+
+            static plan_type plan_many_dft_r2c(int n, int howmany, float* in, int istride, int idist,
+                                               complex_type* out, int ostride, int odist, unsigned flags) {
+                return fftwf_plan_many_dft_r2c(1, &n, howmany, in, nullptr, istride, idist, out, nullptr, ostride,
+                                             odist, flags);
+            }
+
+            static plan_type plan_many_dft_c2r(int n, int howmany, complex_type* in, int istride, int idist,
+                                               float* out, int ostride, int odist, unsigned flags) {
+                return fftwf_plan_many_dft_c2r(1, &n, howmany, in, nullptr, istride, idist, out, nullptr, ostride,
+                                             odist, flags);
+            }
+
+            static plan_type plan_guru_split_dft(int n, float* ri, float* ii, float* ro, float* io, unsigned flags) {
+                const fftwf_iodim dimension{n, 1, 1};
+                return fftwf_plan_guru_split_dft(1, &dimension, 0, nullptr, ri, ii, ro, io, flags);
+            }
+
+            static plan_type plan_guru_split_dft_r2c(int n, float* in, float* ro, float* io, unsigned flags) {
+                const fftwf_iodim dimension{n, 1, 1};
+                return fftwf_plan_guru_split_dft_r2c(1, &dimension, 0, nullptr, in, ro, io, flags);
+            }
+
+            static plan_type plan_guru_split_dft_c2r(int n, float* ri, float* ii, float* out, unsigned flags) {
+                const fftwf_iodim dimension{n, 1, 1};
+                return fftwf_plan_guru_split_dft_c2r(1, &dimension, 0, nullptr, ri, ii, out, flags);
+            }
+
+            static void execute_dft(plan_type plan, complex_type* in, complex_type* out) {
+                fftwf_execute_dft(plan, in, out);
+            }
+
+            static void execute_dft_r2c(plan_type plan, float* in, complex_type* out) {
+                fftwf_execute_dft_r2c(plan, in, out);
+            }
+
+            static void execute_dft_c2r(plan_type plan, complex_type* in, float* out) {
+                fftwf_execute_dft_c2r(plan, in, out);
+            }
+
+            static void execute_r2r(plan_type plan, float* in, float* out) {
+                fftwf_execute_r2r(plan, in, out);
+            }
+
+            static void execute_split_dft(plan_type plan, float* ri, float* ii, float* ro, float* io) {
+                fftwf_execute_split_dft(plan, ri, ii, ro, io);
+            }
+
+            static void execute_split_dft_r2c(plan_type plan, float* in, float* ro, float* io) {
+                fftwf_execute_split_dft_r2c(plan, in, ro, io);
+            }
+
+            static void execute_split_dft_c2r(plan_type plan, float* ri, float* ii, float* out) {
+                fftwf_execute_split_dft_c2r(plan, ri, ii, out);
+            }
+
+            static void destroy_plan(plan_type plan) {
+                fftwf_destroy_plan(plan);
+            }
+
+            static int alignment_of(const void* p) {
+                return fftwf_alignment_of(static_cast<float*>(const_cast<void*>(p)));
+            }
+
+            static void* malloc(std::size_t bytes) {
+                return fftwf_malloc(bytes);
+            }
+
+            static void free(void* p) {
+                fftwf_free(p);
+            }
+
+            static bool import_wisdom_from_filename(const char* filename) {
+                return fftwf_import_wisdom_from_filename(filename) != 0;
+            }
+
+            static bool export_wisdom_to_filename(const char* filename) {
+                return fftwf_export_wisdom_to_filename(filename) != 0;
+            }
+
+            static bool import_wisdom_from_string(const char* wisdom) {
+                return fftwf_import_wisdom_from_string(wisdom) != 0;
+            }
+
+            static char* export_wisdom_to_string() {
+                return fftwf_export_wisdom_to_string();
+            }
+
+            static void forget_wisdom() {
+                fftwf_forget_wisdom();
+            }
+
+            // The number of threads is a global setting of the planner, it applies to the plans created afterwards.
+            static void plan_with_nthreads(int threads) {
+#if defined(USE_LIBFFTW_THREADS)
+                static const bool initialized = fftwf_init_threads() != 0;
+                if (initialized) {
+                    fftwf_plan_with_nthreads(threads);
+                }
+#else
+                static_cast<void>(threads);
+#endif
+            }
+        };
+
+        template <>
+        struct fftw_api<double> {
+            using plan_type    = ::fftw_plan;
+            using complex_type = ::fftw_complex;
+
+            static plan_type plan_dft_1d(int n, complex_type* in, complex_type* out, int sign, unsigned flags) {
+                return fftw_plan_dft_1d(n, in, out, sign, flags);
+            }
+
+            static plan_type plan_dft_r2c_1d(int n, double* in, complex_type* out, unsigned flags) {
+                return fftw_plan_dft_r2c_1d(n, in, out, flags);
+            }
+
+            static plan_type plan_dft_c2r_1d(int n, complex_type* in, double* out, unsigned flags) {
+                return fftw_plan_dft_c2r_1d(n, in, out, flags);
+            }
+
+            static plan_type plan_r2r_1d(int n, double* in, double* out, fftw_r2r_kind kind, unsigned flags) {
+                return fftw_plan_r2r_1d(n, in, out, kind, flags);
+            }
+
+            static plan_type plan_many_dft(int n, int howmany, complex_type* in, int istride, int idist,
+                                           complex_type* out, int ostride, int odist, int sign, unsigned flags) {
+                return fftw_plan_many_dft(1, &n, howmany, in, nullptr, istride, idist, out, nullptr, ostride, odist,
+                                        sign, flags);
+            }
+
+            static plan_type plan_many_dft_r2c(int n, int howmany, double* in, int istride, int idist,
+                                               complex_type* out, int ostride, int odist, unsigned flags) {
+                return fftw_plan_many_dft_r2c(1, &n, howmany, in, nullptr, istride, idist, out, nullptr, ostride,
+                                            odist, flags);
+            }
+
+            static plan_type plan_many_dft_c2r(int n, int howmany, complex_type* in, int istride, int idist,
+                                               double* out, int ostride, int odist, unsigned flags) {
+                return fftw_plan_many_dft_c2r(1, &n, howmany, in, nullptr, istride, idist, out, nullptr, ostride,
+                                            odist, flags);
+            }
+
+            static plan_type plan_guru_split_dft(int n, double* ri, double* ii, double* ro, double* io,
+                                                 unsigned flags) {
+                const fftw_iodim dimension{n, 1, 1};
+                return fftw_plan_guru_split_dft(1, &dimension, 0, nullptr, ri, ii, ro, io, flags);
+            }
+
+            static plan_type plan_guru_split_dft_r2c(int n, double* in, double* ro, double* io, unsigned flags) {
+                const fftw_iodim dimension{n, 1, 1};
+                return fftw_plan_guru_split_dft_r2c(1, &dimension, 0, nullptr, in, ro, io, flags);
+            }
+
+            static plan_type plan_guru_split_dft_c2r(int n, double* ri, double* ii, double* out, unsigned flags) {
+                const fftw_iodim dimension{n, 1, 1};
+                return fftw_plan_guru_split_dft_c2r(1, &dimension, 0, nullptr, ri, ii, out, flags);
+            }
+
+            static void execute_dft(plan_type plan, complex_type* in, complex_type* out) {
+                fftw_execute_dft(plan, in, out);
+            }
+
+            static void execute_dft_r2c(plan_type plan, double* in, complex_type* out) {
+                fftw_execute_dft_r2c(plan, in, out);
+            }
+
+            static void execute_dft_c2r(plan_type plan, complex_type* in, double* out) {
+                fftw_execute_dft_c2r(plan, in, out);
+            }
+
+            static void execute_r2r(plan_type plan, double* in, double* out) {
+                fftw_execute_r2r(plan, in, out);
+            }
+
+            static void execute_split_dft(plan_type plan, double* ri, double* ii, double* ro, double* io) {
+                fftw_execute_split_dft(plan, ri, ii, ro, io);
+            }
+
+            static void execute_split_dft_r2c(plan_type plan, double* in, double* ro, double* io) {
+                fftw_execute_split_dft_r2c(plan, in, ro, io);
+            }
+
+            static void execute_split_dft_c2r(plan_type plan, double* ri, double* ii, double* out) {
+                fftw_execute_split_dft_c2r(plan, ri, ii, out);
+            }
+
+            static void destroy_plan(plan_type plan) {
+                fftw_destroy_plan(plan);
+            }
+
+            static int alignment_of(const void* p) {
+                return fftw_alignment_of(static_cast<double*>(const_cast<void*>(p)));
+            }
+
+            static void* malloc(std::size_t bytes) {
+                return fftw_malloc(bytes);
+            }
+
+            static void free(void* p) {
+                fftw_free(p);
+            }
+
+            static bool import_wisdom_from_filename(const char* filename) {
+                return fftw_import_wisdom_from_filename(filename) != 0;
+            }
+
+            static bool export_wisdom_to_filename(const char* filename) {
+                return fftw_export_wisdom_to_filename(filename) != 0;
+            }
+
+            static bool import_wisdom_from_string(const char* wisdom) {
+                return fftw_import_wisdom_from_string(wisdom) != 0;
+            }
+
+            static char* export_wisdom_to_string() {
+                return fftw_export_wisdom_to_string();
+            }
+
+            static void forget_wisdom() {
+                fftw_forget_wisdom();
+            }
+
+            // The number of threads is a global setting of the planner, it applies to the plans created afterwards.
+            static void plan_with_nthreads(int threads) {
+#if defined(USE_LIBFFTW_THREADS)
+                static const bool initialized = fftw_init_threads() != 0;
+                if (initialized) {
+                    fftw_plan_with_nthreads(threads);
+                }
+#else
+                static_cast<void>(threads);
+#endif
+            }
+        };
+
+        constexpr unsigned fftw_flags(planning_rigor rigor) noexcept {
+            switch (rigor) {
+                case planning_rigor::Measure:
+                    return FFTW_MEASURE;
+                case planning_rigor::Patient:
+                    return FFTW_PATIENT;
+                case planning_rigor::Exhaustive:
+                    return FFTW_EXHAUSTIVE;
+                default:
+                    return FFTW_ESTIMATE;
+            }
+        }
+
+        // The threaded planner is only available when linking against the threaded FFTW libraries.
+        inline int fftw_threads(int requested) noexcept {
+#if defined(USE_LIBFFTW_THREADS)
+            return std::max(requested, 1);
+#else
+            static_cast<void>(requested);
+            return 1;
+#endif
+        }
+
+        /**
+         * @brief Owns an FFTW plan shared through the %plan_cache.
+         *
+         * The FFTW planner is not thread-safe, the plan is destroyed while holding the planner mutex.
+         */
+        template <typename T>
+        struct fftw_plan_holder {
+            using plan_type = typename fftw_api<T>::plan_type;
+
+            explicit fftw_plan_holder(plan_type plan) : plan(plan) {}
+
+            ~fftw_plan_holder() {
+                std::lock_guard<std::mutex> lock(plan_cache::instance().planner_mutex());
+                fftw_api<T>::destroy_plan(plan);
+            }
+
+            fftw_plan_holder(const fftw_plan_holder&) = delete;
+            fftw_plan_holder& operator=(const fftw_plan_holder&) = delete;
+
+            plan_type plan;
+        };
+
     } // namespace internal
 
     template <typename T>
-    struct fftw_impl {};
+    struct fftw_impl {
+        static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                      "FFTW only supports single and double precision");
 
-    template <>
-    struct fftw_impl<float> {
-        using value_type   = float;
-        using complex_type = std::complex<float>;
+        using value_type   = T;
+        using complex_type = std::complex<T>;
         using size_type    = int;
 
-        explicit fftw_impl(size_type nfft) : nfft_(nfft) {}
+        // FFTW selects its SIMD codelets when the buffers satisfy the alignment of the widest enabled instruction set.
+        static constexpr std::size_t alignment = default_alignment;
 
-        ~fftw_impl() {
-            if (!meta::is_null(plan_)) {
-                fftwf_destroy_plan(plan_);
-            }
+        explicit fftw_impl(size_type nfft, planning_rigor rigor = planning_rigor::Estimate, size_type threads = 1) :
+            nfft_(nfft),
+            rigor_(rigor),
+            threads_(internal::fftw_threads(threads)) {}
+
+        inline planning_rigor rigor() const noexcept {
+            return rigor_;
+        }
+
+        inline size_type threads() const noexcept {
+            return threads_;
+        }
+
+        inline size_type size() const noexcept {
+            return nfft_;
         }
 
         inline void dft(const complex_type* src, complex_type* dst) {
-            if (meta::is_null(plan_))
-                plan_ = fftwf_plan_dft_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_FORWARD,
-                                          FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            fftwf_execute_dft(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+            const auto planner = [this](complex_type* in, complex_type* out, unsigned flags) {
+                return api::plan_dft_1d(nfft_, internal::fftw_cast(in), internal::fftw_cast(out), FFTW_FORWARD, flags);
+            };
+            const auto& holder = plan(plan_kind::ComplexForward, src, dst, planner);
+            api::execute_dft(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
         }
 
         inline void idft(const complex_type* src, complex_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftwf_plan_dft_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_BACKWARD,
-                                          FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            }
-            fftwf_execute_dft(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+            const auto planner = [this](complex_type* in, complex_type* out, unsigned flags) {
+                return api::plan_dft_1d(nfft_, internal::fftw_cast(in), internal::fftw_cast(out), FFTW_BACKWARD, flags);
+            };
+            const auto& holder = plan(plan_kind::ComplexBackward, src, dst, planner);
+            api::execute_dft(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
         }
 
         inline void dft(const value_type* src, complex_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftwf_plan_dft_r2c_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst),
-                                              FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            }
-            fftwf_execute_dft_r2c(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+            const auto planner = [this](value_type* in, complex_type* out, unsigned flags) {
+                return api::plan_dft_r2c_1d(nfft_, in, internal::fftw_cast(out), flags);
+            };
+            const auto& holder = plan(plan_kind::RealForward, src, dst, planner);
+            api::execute_dft_r2c(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
         }
 
         inline void idft(const complex_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftwf_plan_dft_c2r_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst),
-                                              FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            }
-            fftwf_execute_dft_c2r(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+            const auto planner = [this](complex_type* in, value_type* out, unsigned flags) {
+                return api::plan_dft_c2r_1d(nfft_, internal::fftw_cast(in), out, flags);
+            };
+            const auto& holder = plan(plan_kind::RealBackward, src, dst, planner);
+            api::execute_dft_c2r(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
         }
 
         inline void dht(const value_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftwf_plan_r2r_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_DHT,
-                                          FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            }
-            fftwf_execute_r2r(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+            const auto planner = [this](value_type* in, value_type* out, unsigned flags) {
+                return api::plan_r2r_1d(nfft_, in, out, FFTW_DHT, flags);
+            };
+            const auto& holder = plan(plan_kind::Hartley, src, dst, planner);
+            api::execute_r2r(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
         }
 
         inline void dct(const value_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftwf_plan_r2r_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_REDFT10,
-                                          FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            }
-            fftwf_execute_r2r(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+            const auto planner = [this](value_type* in, value_type* out, unsigned flags) {
+                return api::plan_r2r_1d(nfft_, in, out, FFTW_REDFT10, flags);
+            };
+            const auto& holder = plan(plan_kind::DctII, src, dst, planner);
+            api::execute_r2r(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
         }
 
         inline void idct(const value_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftwf_plan_r2r_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_REDFT01,
-                                          FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            const auto planner = [this](value_type* in, value_type* out, unsigned flags) {
+                return api::plan_r2r_1d(nfft_, in, out, FFTW_REDFT01, flags);
+            };
+            const auto& holder = plan(plan_kind::DctIII, src, dst, planner);
+            api::execute_r2r(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
+        }
+
+        inline void dft(const split_complex_view<const value_type>& src, const split_complex_view<value_type>& dst) {
+            split_complex_transform(plan_kind::SplitComplex, src, dst);
+        }
+
+        inline void idft(const split_complex_view<const value_type>& src, const split_complex_view<value_type>& dst) {
+            split_complex_transform(plan_kind::SplitComplexBackward, src, dst);
+        }
+
+        inline void dft(const value_type* src, const split_complex_view<value_type>& dst) {
+            const auto count   = static_cast<std::size_t>(nfft_ / 2 + 1);
+            const auto stride  = split_stride(count);
+            const auto copy    = !split_layout(dst, stride);
+            auto* ro           = copy ? split_scratch(0) : dst.real();
+            auto* io           = copy ? ro + stride : dst.imag();
+            const auto planner = [this, stride](value_type* in, value_type* out, unsigned flags) {
+                return api::plan_guru_split_dft_r2c(nfft_, in, out, out + stride, flags);
+            };
+            const auto in_place = static_cast<const void*>(src) == static_cast<const void*>(ro);
+            const auto aligned =
+                api::alignment_of(src) == 0 && api::alignment_of(ro) == 0 && api::alignment_of(io) == 0;
+            const auto& holder = plan<value_type, value_type>(
+                plans_[static_cast<std::size_t>(plan_kind::SplitForward)],
+                make_key(plan_kind::SplitForward, in_place, aligned), nfft_ * sizeof(T), 2 * stride * sizeof(T),
+                planner);
+            api::execute_split_dft_r2c(holder.plan, internal::fftw_cast(src), ro, io);
+            if (copy) {
+                std::copy(ro, ro + count, dst.real());
+                std::copy(io, io + count, dst.imag());
+            }
+        }
+
+        inline void idft(const split_complex_view<const value_type>& src, value_type* dst) {
+            const auto count   = static_cast<std::size_t>(nfft_ / 2 + 1);
+            const auto stride  = split_stride(count);
+            const auto* ri     = src.real();
+            const auto* ii     = src.imag();
+            if (!split_layout(src, stride)) {
+                auto* scratch = split_scratch(0);
+                std::copy(ri, ri + count, scratch);
+                std::copy(ii, ii + count, scratch + stride);
+                ri = scratch;
+                ii = scratch + stride;
             }
-            fftwf_execute_r2r(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+            const auto planner = [this, stride](value_type* in, value_type* out, unsigned flags) {
+                return api::plan_guru_split_dft_c2r(nfft_, in, in + stride, out, flags);
+            };
+            const auto in_place = static_cast<const void*>(ri) == static_cast<const void*>(dst);
+            const auto aligned =
+                api::alignment_of(ri) == 0 && api::alignment_of(ii) == 0 && api::alignment_of(dst) == 0;
+            const auto& holder = plan<value_type, value_type>(
+                plans_[static_cast<std::size_t>(plan_kind::SplitBackward)],
+                make_key(plan_kind::SplitBackward, in_place, aligned), 2 * stride * sizeof(T), nfft_ * sizeof(T),
+                planner);
+            api::execute_split_dft_c2r(holder.plan, internal::fftw_cast(ri), internal::fftw_cast(ii), dst);
+        }
+
+        inline void dft_many(const complex_type* src, complex_type* dst, size_type howmany, size_type istride,
+                             size_type idist, size_type ostride, size_type odist) {
+            const auto planner = [&](complex_type* in, complex_type* out, unsigned flags) {
+                return api::plan_many_dft(nfft_, howmany, internal::fftw_cast(in), istride, idist,
+                                          internal::fftw_cast(out), ostride, odist, FFTW_FORWARD, flags);
+            };
+            const batch_layout layout{howmany, istride, idist, nfft_, ostride, odist, nfft_};
+            const auto& holder = plan_many(plan_kind::ComplexForward, src, dst, layout, planner);
+            api::execute_dft(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
+        }
+
+        inline void idft_many(const complex_type* src, complex_type* dst, size_type howmany, size_type istride,
+                              size_type idist, size_type ostride, size_type odist) {
+            const auto planner = [&](complex_type* in, complex_type* out, unsigned flags) {
+                return api::plan_many_dft(nfft_, howmany, internal::fftw_cast(in), istride, idist,
+                                          internal::fftw_cast(out), ostride, odist, FFTW_BACKWARD, flags);
+            };
+            const batch_layout layout{howmany, istride, idist, nfft_, ostride, odist, nfft_};
+            const auto& holder = plan_many(plan_kind::ComplexBackward, src, dst, layout, planner);
+            api::execute_dft(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
+        }
+
+        inline void dft_many(const value_type* src, complex_type* dst, size_type howmany, size_type istride,
+                             size_type idist, size_type ostride, size_type odist) {
+            const auto planner = [&](value_type* in, complex_type* out, unsigned flags) {
+                return api::plan_many_dft_r2c(nfft_, howmany, in, istride, idist, internal::fftw_cast(out), ostride,
+                                              odist, flags);
+            };
+            const batch_layout layout{howmany, istride, idist, nfft_, ostride, odist, nfft_ / 2 + 1};
+            const auto& holder = plan_many(plan_kind::RealForward, src, dst, layout, planner);
+            api::execute_dft_r2c(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
+        }
+
+        inline void idft_many(const complex_type* src, value_type* dst, size_type howmany, size_type istride,
+                              size_type idist, size_type ostride, size_type odist) {
+            const auto planner = [&](complex_type* in, value_type* out, unsigned flags) {
+                return api::plan_many_dft_c2r(nfft_, howmany, internal::fftw_cast(in), istride, idist, out, ostride,
+                                              odist, flags);
+            };
+            const batch_layout layout{howmany, istride, idist, nfft_ / 2 + 1, ostride, odist, nfft_};
+            const auto& holder = plan_many(plan_kind::RealBackward, src, dst, layout, planner);
+            api::execute_dft_c2r(holder.plan, internal::fftw_cast(src), internal::fftw_cast(dst));
         }
 
         inline void idft_scale(value_type* dst) const {
@@ -143,101 +576,236 @@ namespace edsp { inline namespace spectral {
         }
 
     private:
-        ::fftwf_plan plan_{nullptr};
-        size_type nfft_;
-    };
-
-    template <>
-    struct fftw_impl<double> {
-        using value_type   = double;
-        using complex_type = std::complex<double>;
-        using size_type    = int;
+        using api         = internal::fftw_api<T>;
+        using plan_holder = internal::fftw_plan_holder<T>;
+
+        struct plan_slot {
+            std::shared_ptr<plan_holder> holder{nullptr};
+            plan_key key{};
+        };
+
+        // Aligned and unaligned buffers are transformed with different plans. Both are kept, so that callers
+        // alternating them (e.g. frames stored at arbitrary offsets of a larger buffer) do not request the plans to
+        // the cache in every call.
+        using plan_slots = std::array<plan_slot, 2>;
+
+        // Geometry of a batched transform, the counts are the number of samples of every input and output frame.
+        struct batch_layout {
+            size_type howmany;
+            size_type istride;
+            size_type idist;
+            size_type icount;
+            size_type ostride;
+            size_type odist;
+            size_type ocount;
+        };
+
+        // Every kind of transform has its own plan, created lazily in the first call. The plan is requested again
+        // if the layout of the buffers changes, as FFTW plans can only be executed over buffers with the same layout.
+        template <typename I, typename O, typename Planner>
+        const plan_holder& plan(plan_kind kind, const I* src, const O* dst, Planner&& planner) {
+            // Enough space for the largest buffer: nfft complex samples.
+            const auto bytes = 2 * static_cast<std::size_t>(nfft_ + 2) * sizeof(T);
+            return plan<I, O>(plans_[static_cast<std::size_t>(kind)], make_key(kind, src, dst), bytes, bytes,
+                              std::forward<Planner>(planner));
+        }
 
-        explicit fftw_impl(size_type nfft) : nfft_(nfft) {}
+        // Batched plans are kept apart from the single ones, so that both can be used alternatively without
+        // requesting the plans to the cache in every call.
+        template <typename I, typename O, typename Planner>
+        const plan_holder& plan_many(plan_kind kind, const I* src, const O* dst, const batch_layout& layout,
+                                     Planner&& planner) {
+            meta::expects(layout.howmany > 0 && layout.istride > 0 && layout.ostride > 0 && layout.idist >= 0 &&
+                              layout.odist >= 0,
+                          "Invalid layout of the batched transform");
+            auto key    = make_key(kind, src, dst);
+            key.howmany = static_cast<std::size_t>(layout.howmany);
+            key.istride = static_cast<std::size_t>(layout.istride);
+            key.idist   = static_cast<std::size_t>(layout.idist);
+            key.ostride = static_cast<std::size_t>(layout.ostride);
+            key.odist   = static_cast<std::size_t>(layout.odist);
+
+            const auto input  = extent(layout.icount, layout.howmany, layout.istride, layout.idist) * sizeof(I);
+            const auto output = extent(layout.ocount, layout.howmany, layout.ostride, layout.odist) * sizeof(O);
+            return plan<I, O>(batched_[static_cast<std::size_t>(kind)], key, input, output,
+                              std::forward<Planner>(planner));
+        }
 
-        ~fftw_impl() {
-            if (!meta::is_null(plan_)) {
-                fftw_destroy_plan(plan_);
+        template <typename I, typename O, typename Planner>
+        const plan_holder& plan(plan_slots& slots, const plan_key& key, std::size_t input, std::size_t output,
+                                Planner&& planner) {
+            auto& slot = slots[key.aligned ? 1 : 0];
+            if (meta::is_null(slot.holder) || slot.key != key) {
+                slot.holder = make_plan<I, O>(key, input, output, std::forward<Planner>(planner));
+                slot.key    = key;
+                meta::expects(!meta::is_null(slot.holder), "Unable to create the FFT plan");
             }
+            return *slot.holder;
         }
 
-        inline void dft(const complex_type* src, complex_type* dst) {
-            if (meta::is_null(plan_))
-                plan_ = fftw_plan_dft_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_FORWARD,
-                                         FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            fftw_execute_dft(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+        template <typename I, typename O>
+        plan_key make_key(plan_kind kind, const I* src, const O* dst) const {
+            const auto in_place = static_cast<const void*>(src) == static_cast<const void*>(dst);
+            const auto aligned  = api::alignment_of(src) == 0 && api::alignment_of(dst) == 0;
+            return make_key(kind, in_place, aligned);
         }
 
-        inline void idft(const complex_type* src, complex_type* dst) {
-            if (meta::is_null(plan_))
-                plan_ = fftw_plan_dft_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_BACKWARD,
-                                         FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            fftw_execute_dft(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+        plan_key make_key(plan_kind kind, bool in_place, bool aligned) const {
+            plan_key key{sizeof(T), static_cast<std::size_t>(nfft_), kind, rigor_, in_place, aligned};
+            key.threads = static_cast<std::size_t>(threads_);
+            return key;
         }
 
-        inline void dft(const value_type* src, complex_type* dst) {
-            if (meta::is_null(plan_))
-                plan_ = fftw_plan_dft_r2c_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst),
-                                             FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            fftw_execute_dft_r2c(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+        // The split plans are created over buffers storing the real parts followed by the imaginary ones, with the
+        // layout of split_complex_buffer. FFTW can only execute them over arrays with the same distance between the
+        // real and the imaginary parts, buffers with any other layout are copied through a scratch buffer.
+        static std::size_t split_stride(std::size_t count) noexcept {
+            return internal::split_stride<T>(count);
         }
 
-        inline void idft(const complex_type* src, value_type* dst) {
-            if (meta::is_null(plan_))
-                plan_ = fftw_plan_dft_c2r_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst),
-                                             FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            fftw_execute_dft_c2r(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+        template <typename U>
+        static bool split_layout(const split_complex_view<U>& view, std::size_t stride) noexcept {
+            return view.imag() - view.real() == static_cast<std::ptrdiff_t>(stride);
         }
 
-        inline void dht(const value_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftw_plan_r2r_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_DHT,
-                                         FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+        // Room for an input and an output split buffer of nfft samples, allocated in the first call that needs it.
+        value_type* split_scratch(std::size_t offset) {
+            if (scratch_.empty()) {
+                scratch_.resize(4 * split_stride(static_cast<std::size_t>(nfft_)));
             }
-            fftw_execute_r2r(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+            return scratch_.data() + offset;
         }
 
-        inline void dct(const value_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftw_plan_r2r_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_REDFT10,
-                                         FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+        void split_complex_transform(plan_kind kind, const split_complex_view<const value_type>& src,
+                                     const split_complex_view<value_type>& dst) {
+            const auto count  = static_cast<std::size_t>(nfft_);
+            const auto stride = split_stride(count);
+            const auto* ri    = src.real();
+            const auto* ii    = src.imag();
+            if (!split_layout(src, stride)) {
+                auto* scratch = split_scratch(0);
+                std::copy(ri, ri + count, scratch);
+                std::copy(ii, ii + count, scratch + stride);
+                ri = scratch;
+                ii = scratch + stride;
+            }
+            const auto copy = !split_layout(dst, stride);
+            auto* ro        = copy ? split_scratch(2 * stride) : dst.real();
+            auto* io        = copy ? ro + stride : dst.imag();
+
+            // The backward transform is the forward one with the real and imaginary parts swapped, so its plan is
+            // created with the swapped arrays to keep the distance between them.
+            const auto backward = kind == plan_kind::SplitComplexBackward;
+            const auto planner  = [this, stride, backward](value_type* in, value_type* out, unsigned flags) {
+                return backward ? api::plan_guru_split_dft(nfft_, in + stride, in, out + stride, out, flags)
+                                : api::plan_guru_split_dft(nfft_, in, in + stride, out, out + stride, flags);
+            };
+            const auto in_place = ri == ro;
+            const auto aligned  = api::alignment_of(ri) == 0 && api::alignment_of(ii) == 0 &&
+                                 api::alignment_of(ro) == 0 && api::alignment_of(io) == 0;
+            const auto bytes = 2 * stride * sizeof(T);
+            const auto& holder =
+                plan<value_type, value_type>(plans_[static_cast<std::size_t>(kind)],
+                                             make_key(kind, in_place, aligned), bytes, bytes, planner);
+            if (backward) {
+                api::execute_split_dft(holder.plan, internal::fftw_cast(ii), internal::fftw_cast(ri), io, ro);
+            } else {
+                api::execute_split_dft(holder.plan, internal::fftw_cast(ri), internal::fftw_cast(ii), ro, io);
+            }
+            if (copy) {
+                std::copy(ro, ro + count, dst.real());
+                std::copy(io, io + count, dst.imag());
             }
-            fftw_execute_r2r(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
         }
 
-        inline void idct(const value_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = fftw_plan_r2r_1d(nfft_, internal::fftw_cast(src), internal::fftw_cast(dst), FFTW_REDFT01,
-                                         FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-            }
-            fftw_execute_r2r(plan_, internal::fftw_cast(src), internal::fftw_cast(dst));
+        static std::size_t extent(size_type count, size_type howmany, size_type stride, size_type dist) noexcept {
+            return static_cast<std::size_t>((howmany - 1) * dist + (count - 1) * stride + 1);
         }
 
-        inline void idft_scale(value_type* dst) const {
-            const auto scaling = static_cast<value_type>(nfft_);
-            for (size_type i = 0; i < nfft_; ++i) {
-                dst[i] /= scaling;
-            }
+        // The planner may overwrite the buffers while measuring, so plans are always created over scratch buffers
+        // with the same layout (in-place/out-of-place and alignment) as the user buffers.
+        template <typename I, typename O, typename Planner>
+        std::shared_ptr<plan_holder> make_plan(const plan_key& key, std::size_t input, std::size_t output,
+                                               Planner&& planner) const {
+            auto& cache = plan_cache::instance();
+            return cache.template acquire<plan_holder>(key, [&]() -> std::shared_ptr<plan_holder> {
+                auto flags = internal::fftw_flags(rigor_);
+                if (!key.in_place) {
+                    flags |= FFTW_PRESERVE_INPUT;
+                }
+                if (!key.aligned) {
+                    flags |= FFTW_UNALIGNED;
+                }
+
+                std::lock_guard<std::mutex> lock(cache.planner_mutex());
+                api::plan_with_nthreads(static_cast<int>(key.threads));
+                auto* in  = api::malloc(key.in_place ? std::max(input, output) : input);
+                auto* out = key.in_place ? in : api::malloc(output);
+                const auto plan = planner(static_cast<I*>(in), static_cast<O*>(out), flags);
+                if (!key.in_place) {
+                    api::free(out);
+                }
+                api::free(in);
+
+                if (meta::is_null(plan)) {
+                    return nullptr;
+                }
+                return std::make_shared<plan_holder>(plan);
+            });
         }
 
-        inline void idft_scale(complex_type* dst) const {
-            const auto scaling = static_cast<value_type>(nfft_);
-            for (size_type i = 0; i < nfft_; ++i) {
-                dst[i] /= scaling;
-            }
+        std::array<plan_slots, 11> plans_{};
+        std::array<plan_slots, 4> batched_{};
+        std::vector<value_type, aligned_allocator<value_type>> scratch_{};
+        size_type nfft_;
+        planning_rigor rigor_;
+        size_type threads_;
+    };
+
+    /**
+     * @brief Wisdom management for the FFTW backend.
+     *
+     * The wisdom accumulates the results of the rigorous planning stages. It can be exported when the process
+     * finishes and imported at startup, so that following plans are created instantly.
+     */
+    template <typename T>
+    struct fftw_wisdom {
+        static bool import_from_file(const std::string& filename) {
+            std::lock_guard<std::mutex> lock(plan_cache::instance().planner_mutex());
+            return api::import_wisdom_from_filename(filename.c_str());
         }
 
-        inline void idct_scale(value_type* dst) const {
-            const auto scaling = 2 * nfft_;
-            for (size_type i = 0; i < nfft_; ++i) {
-                dst[i] /= scaling;
+        static bool export_to_file(const std::string& filename) {
+            std::lock_guard<std::mutex> lock(plan_cache::instance().planner_mutex());
+            return api::export_wisdom_to_filename(filename.c_str());
+        }
+
+        static bool import_from_string(const std::string& wisdom) {
+            std::lock_guard<std::mutex> lock(plan_cache::instance().planner_mutex());
+            return api::import_wisdom_from_string(wisdom.c_str());
+        }
+
+        static std::string export_to_string() {
+            std::lock_guard<std::mutex> lock(plan_cache::instance().planner_mutex());
+            auto* exported = api::export_wisdom_to_string();
+            if (exported == nullptr) {
+                return std::string();
             }
+            const std::string wisdom(exported);
+            // FFTW allocates the exported string with malloc, not with fftw_malloc.
+            std::free(exported);
+            return wisdom;
+        }
+
+        static void forget() {
+            std::lock_guard<std::mutex> lock(plan_cache::instance().planner_mutex());
+            api::forget_wisdom();
         }
 
     private:
-        ::fftw_plan plan_{nullptr};
-        size_type nfft_;
+        using api = internal::fftw_api<T>;
     };
+
 }} // namespace edsp::spectral
 
 #endif // EDSP_FFTW_IMPL_HPP
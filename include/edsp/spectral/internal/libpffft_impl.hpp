@@ -27,96 +27,82 @@
 #include <edsp/meta/iterator.hpp>
 #include <edsp/meta/expects.hpp>
 #include <edsp/meta/data.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/spectral/plan_cache.hpp>
+#include <edsp/spectral/split_complex.hpp>
+#include <edsp/types/aligned_allocator.hpp>
 
 #include <complex>
 #include <pffft.h>
 #include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace edsp { inline namespace spectral {
 
     namespace internal {
 
-        inline void forward_transform(float* vec, float* temp, size_t len) {
-            if (len == 1)
-                return;
-            size_t halfLen = len / 2;
-            for (size_t i = 0; i < halfLen; i++) {
-                float x           = vec[i];
-                float y           = vec[len - 1 - i];
-                temp[i]           = x + y;
-                temp[i + halfLen] = (x - y) / (std::cos((i + 0.5f) * math::constants<float>::pi / len) * 2);
+        /**
+         * @brief Owns a PFFFT setup shared through the %plan_cache.
+         */
+        struct pffft_setup_holder {
+            explicit pffft_setup_holder(PFFFT_Setup* setup) : setup(setup) {}
+
+            ~pffft_setup_holder() {
+                pffft_destroy_setup(setup);
             }
-            forward_transform(temp, vec, halfLen);
-            forward_transform(&temp[halfLen], vec, halfLen);
-            for (size_t i = 0; i < halfLen - 1; i++) {
-                vec[i * 2 + 0] = temp[i];
-                vec[i * 2 + 1] = temp[i + halfLen] + temp[i + halfLen + 1];
+
+            pffft_setup_holder(const pffft_setup_holder&) = delete;
+            pffft_setup_holder& operator=(const pffft_setup_holder&) = delete;
+
+            PFFFT_Setup* setup;
+        };
+
+        struct pffft_deleter {
+            void operator()(float* p) const noexcept {
+                pffft_aligned_free(p);
             }
-            vec[len - 2] = temp[halfLen - 1];
-            vec[len - 1] = temp[len - 1];
+        };
+
+        /**
+         * @brief Zero-initialized buffer aligned as required by the PFFFT transforms.
+         */
+        using pffft_buffer = std::unique_ptr<float[], pffft_deleter>;
+
+        inline pffft_buffer make_pffft_buffer(std::size_t size) {
+            pffft_buffer buffer(static_cast<float*>(pffft_aligned_malloc(size * sizeof(float))));
+            std::fill(buffer.get(), buffer.get() + size, 0.0f);
+            return buffer;
         }
 
-        inline void inverse_transform(float* vec, float* temp, size_t len) {
-            if (len == 1)
-                return;
-            size_t halfLen = len / 2;
-            temp[0]        = vec[0];
-            temp[halfLen]  = vec[1];
-            for (size_t i = 1; i < halfLen; i++) {
-                temp[i]           = vec[i * 2];
-                temp[i + halfLen] = vec[i * 2 - 1] + vec[i * 2 + 1];
-            }
-            inverse_transform(temp, vec, halfLen);
-            inverse_transform(&temp[halfLen], vec, halfLen);
-            for (size_t i = 0; i < halfLen; i++) {
-                float x          = temp[i];
-                float y          = temp[i + halfLen] / (std::cos((i + 0.5f) * math::constants<float>::pi / len) * 2);
-                vec[i]           = x + y;
-                vec[len - 1 - i] = x - y;
-            }
-        }
-
-        // DCT type II, unscaled. Algorithm by Byeong Gi Lee, 1984.
-        // See: http://citeseerx.ist.psu.edu/viewdoc/download?doi=10.1.1.118.3056&rep=rep1&type=pdf#page=34
-        inline void dct(float* vec, size_t len) {
-            std::vector<float> temp(len);
-            forward_transform(vec, temp.data(), len);
-            for (size_t i = 0; i < len; ++i) {
-                vec[i] *= 2;
-            }
-        }
-
-        // DCT type III, unscaled. Algorithm by Byeong Gi Lee, 1984.
-        // See: http://tsp7.snu.ac.kr/int_jour/IJ_2.pdf
-        inline void idct(float* vec, size_t len) {
-            for (size_t i = 0; i < len; ++i) {
-                vec[i] *= 2;
-            }
-            vec[0] /= 2;
-            std::vector<float> temp(len);
-            inverse_transform(vec, temp.data(), len);
-        }
-
-        template <typename T, typename R>
-        void useless_idct(const T* input, T* dst, R N) {
-            for (auto k = 0; k < N; ++k) {
-                dst[k] = 0;
-                for (auto j = 1; j < N; ++j) {
-                    dst[k] += input[j] * std::cos(math::constants<T>::pi * j * (k + 0.5) / static_cast<T>(N));
+        /**
+         * @brief Checks if PFFFT is able to compute a transform of the given size: multiple of 16 for complex
+         * transforms, of 32 for real ones, and only factors 2, 3 and 5.
+         */
+        inline bool pffft_supports(int size, pffft_transform_t transform) noexcept {
+            const auto base = (transform == PFFFT_REAL) ? 32 : 16;
+            if (size <= 0 || size % base != 0) {
+                return false;
+            }
+            for (const auto factor : {2, 3, 5}) {
+                while (size % factor == 0) {
+                    size /= factor;
                 }
-                dst[k] = input[0] + 2 * dst[k];
             }
+            return size == 1;
         }
 
-        template <typename T, typename R>
-        void useless_dht(const T* input, T* dst, R N) {
-            for (auto k = 0; k < N; ++k) {
-                dst[k] = 0;
-                for (auto j = 1; j < N; ++j) {
-                    const auto factor = math::constants<T>::two_pi * j * k / static_cast<T>(N);
-                    dst[k] += input[j] * (std::cos(factor) + std::sin(factor));
-                }
+        inline int pffft_next_size(int size) noexcept {
+            while (!pffft_supports(size, PFFFT_COMPLEX)) {
+                ++size;
             }
+            return size;
+        }
+
+        // Size of the transforms computing a complex transform of the given size, or 0 if it is supported.
+        inline int pffft_bluestein_size(int size) noexcept {
+            return pffft_supports(size, PFFFT_COMPLEX) ? 0 : pffft_next_size(2 * size - 1);
         }
 
     } // namespace internal
@@ -124,71 +110,211 @@ namespace edsp { inline namespace spectral {
     template <typename T>
     struct pffft_impl {};
 
+    /**
+     * @brief PFFFT backend.
+     *
+     * The sizes PFFFT does not support are computed with the Bluestein algorithm: the transform is expressed as a
+     * convolution with a chirp, computed with transforms of a supported size. Real transforms of unsupported sizes are
+     * computed as complex ones. The DCT and the DHT are computed from a real transform of the same size.
+     */
     template <>
     struct pffft_impl<float> {
         using value_type   = float;
         using complex_type = std::complex<float>;
         using size_type    = int;
 
-        explicit pffft_impl(size_type nfft) : nfft_(nfft) {
-            work_ = (float*) pffft_aligned_malloc(2 * nfft * sizeof(float));
-            meta::expects(
-                nfft_ % 16 == 0,
-                "Unfortunately, the fft_engine size must be a multiple of 16 for complex FFTs  and 32 for real FFTs");
-        }
+        // PFFFT requires buffers aligned to the size of a SIMD vector of 4 floats.
+        static constexpr std::size_t alignment = 16;
 
-        ~pffft_impl() {
-            if (!meta::is_null(plan_)) {
-                pffft_destroy_setup(plan_);
+        // PFFFT does not implement a planner and is single-threaded, the rigor and the number of threads are only
+        // kept for compatibility with the other backends.
+        explicit pffft_impl(size_type nfft, planning_rigor rigor = planning_rigor::Estimate, size_type threads = 1) :
+            nfft_(nfft),
+            bluestein_size_(internal::pffft_bluestein_size(nfft)),
+            rigor_(rigor) {
+            meta::expects(nfft_ > 0, "The fft_engine size must be positive");
+            const auto size = static_cast<std::size_t>(std::max(nfft_, bluestein_size_));
+            work_           = internal::make_pffft_buffer(2 * size);
+            input_          = internal::make_pffft_buffer(2 * (nfft_ + 2));
+            output_         = internal::make_pffft_buffer(2 * (nfft_ + 2));
+            spectrum_       = internal::make_pffft_buffer(2 * nfft_);
+            make_dct_twiddles();
+            if (bluestein_size_ != 0) {
+                make_bluestein();
             }
-            pffft_aligned_free(work_);
+            static_cast<void>(threads);
+        }
+
+        inline planning_rigor rigor() const noexcept {
+            return rigor_;
+        }
+
+        inline size_type threads() const noexcept {
+            return 1;
+        }
+
+        inline size_type size() const noexcept {
+            return nfft_;
         }
 
         inline void dft(const complex_type* src, complex_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = pffft_new_setup(nfft_, PFFFT_COMPLEX);
-            }
-            pffft_transform_ordered(plan_, reinterpret_cast<const float*>(src), reinterpret_cast<float*>(dst), work_,
-                                    PFFFT_FORWARD);
+            transform(src, dst, PFFFT_FORWARD);
         }
 
         inline void idft(const complex_type* src, complex_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = pffft_new_setup(nfft_, PFFFT_COMPLEX);
-            }
-            pffft_transform_ordered(plan_, reinterpret_cast<const float*>(src), reinterpret_cast<float*>(dst), work_,
-                                    PFFFT_BACKWARD);
+            transform(src, dst, PFFFT_BACKWARD);
         }
 
         inline void dft(const value_type* src, complex_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = pffft_new_setup(nfft_, PFFFT_REAL);
+            const auto bins = nfft_ / 2 + 1;
+            if (!internal::pffft_supports(nfft_, PFFFT_REAL)) {
+                auto* spectrum = reinterpret_cast<complex_type*>(spectrum_.get());
+                for (size_type i = 0; i < nfft_; ++i) {
+                    spectrum[i] = complex_type(src[i], 0);
+                }
+                transform(spectrum, spectrum, PFFFT_FORWARD);
+                std::copy(spectrum, spectrum + bins, dst);
+                return;
+            }
+
+            // The ordered output stores the real parts of the DC and Nyquist bins in the first complex sample.
+            const auto* input = aligned_input(src, nfft_);
+            auto* output      = is_aligned(dst, alignment) ? reinterpret_cast<float*>(dst) : output_.get();
+            pffft_transform_ordered(real_setup(), input, output, work_.get(), PFFFT_FORWARD);
+            const auto nyquist = output[1];
+            output[1]          = 0;
+            if (output != reinterpret_cast<float*>(dst)) {
+                std::copy(output, output + nfft_, reinterpret_cast<float*>(dst));
             }
-            pffft_transform_ordered(plan_, src, reinterpret_cast<float*>(dst), work_, PFFFT_FORWARD);
+            dst[bins - 1] = complex_type(nyquist, 0);
         }
 
         inline void idft(const complex_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = pffft_new_setup(nfft_, PFFFT_REAL);
+            const auto bins = nfft_ / 2 + 1;
+            if (!internal::pffft_supports(nfft_, PFFFT_REAL)) {
+                auto* spectrum = reinterpret_cast<complex_type*>(spectrum_.get());
+                std::copy(src, src + bins, spectrum);
+                for (size_type i = bins; i < nfft_; ++i) {
+                    spectrum[i] = std::conj(src[nfft_ - i]);
+                }
+                transform(spectrum, spectrum, PFFFT_BACKWARD);
+                for (size_type i = 0; i < nfft_; ++i) {
+                    dst[i] = spectrum[i].real();
+                }
+                return;
+            }
+
+            auto* packed = spectrum_.get();
+            std::copy(reinterpret_cast<const float*>(src), reinterpret_cast<const float*>(src) + nfft_, packed);
+            packed[1] = src[bins - 1].real();
+            if (is_aligned(dst, alignment)) {
+                pffft_transform_ordered(real_setup(), packed, dst, work_.get(), PFFFT_BACKWARD);
+            } else {
+                pffft_transform_ordered(real_setup(), packed, output_.get(), work_.get(), PFFFT_BACKWARD);
+                std::copy(output_.get(), output_.get() + nfft_, dst);
             }
-            pffft_transform_ordered(plan_, reinterpret_cast<const float*>(src), dst, work_, PFFFT_BACKWARD);
         }
 
+        // The Hartley transform is cas(x) = Re(X) - Im(X), where X is the Fourier transform of x.
         inline void dht(const value_type* src, value_type* dst) {
-            internal::useless_dht(src, dst, nfft_);
+            auto* spectrum = reinterpret_cast<complex_type*>(output_.get());
+            dft(src, spectrum);
+            for (size_type k = 0; k <= nfft_ / 2; ++k) {
+                dst[k] = spectrum[k].real() - spectrum[k].imag();
+            }
+            for (size_type k = nfft_ / 2 + 1; k < nfft_; ++k) {
+                const auto& bin = spectrum[nfft_ - k];
+                dst[k]          = bin.real() + bin.imag();
+            }
         }
 
+        // DCT type II, unscaled, computed with a real transform of the same size (J. Makhoul, 1980).
         inline void dct(const value_type* src, value_type* dst) {
-            if (meta::is_null(plan_)) {
-                plan_ = pffft_new_setup(nfft_, PFFFT_REAL);
+            const auto* twiddles = dct_twiddles_.data();
+            auto* reordered      = input_.get();
+            auto* spectrum       = reinterpret_cast<complex_type*>(output_.get());
+            for (size_type i = 0; i < nfft_ / 2; ++i) {
+                reordered[i]             = src[2 * i];
+                reordered[nfft_ - 1 - i] = src[2 * i + 1];
+            }
+            if (nfft_ % 2 != 0) {
+                reordered[nfft_ / 2] = src[nfft_ - 1];
+            }
+
+            dft(reordered, spectrum);
+            for (size_type k = 0; k <= nfft_ / 2; ++k) {
+                dst[k] = 2 * (spectrum[k] * twiddles[k]).real();
+            }
+            for (size_type k = nfft_ / 2 + 1; k < nfft_; ++k) {
+                dst[k] = 2 * (std::conj(spectrum[nfft_ - k]) * twiddles[k]).real();
             }
-            std::copy(src, src + nfft_, dst);
-            internal::dct(dst, nfft_);
         }
 
+        // DCT type III, unscaled, inverse of the previous algorithm.
         inline void idct(const value_type* src, value_type* dst) {
-            std::copy(src, src + nfft_, dst);
-            internal::idct(dst, nfft_);
+            const auto* twiddles = dct_twiddles_.data();
+            auto* reordered      = input_.get();
+            auto* spectrum       = reinterpret_cast<complex_type*>(output_.get());
+            spectrum[0]          = complex_type(src[0], 0);
+            for (size_type k = 1; k <= nfft_ / 2; ++k) {
+                spectrum[k] = std::conj(twiddles[k]) * complex_type(src[k], -src[nfft_ - k]);
+            }
+
+            idft(spectrum, reordered);
+            for (size_type i = 0; i < nfft_ / 2; ++i) {
+                dst[2 * i]     = reordered[i];
+                dst[2 * i + 1] = reordered[nfft_ - 1 - i];
+            }
+            if (nfft_ % 2 != 0) {
+                dst[nfft_ - 1] = reordered[nfft_ / 2];
+            }
+        }
+
+        // PFFFT only computes interleaved transforms, split-complex buffers are converted through the scratch buffers.
+        inline void dft(const split_complex_view<const value_type>& src, const split_complex_view<value_type>& dst) {
+            split_transform(src, dst, PFFFT_FORWARD);
+        }
+
+        inline void idft(const split_complex_view<const value_type>& src, const split_complex_view<value_type>& dst) {
+            split_transform(src, dst, PFFFT_BACKWARD);
+        }
+
+        inline void dft(const value_type* src, const split_complex_view<value_type>& dst) {
+            auto* spectrum = reinterpret_cast<complex_type*>(output_.get());
+            dft(src, spectrum);
+            deinterleave(spectrum, dst);
+        }
+
+        inline void idft(const split_complex_view<const value_type>& src, value_type* dst) {
+            auto* spectrum = reinterpret_cast<complex_type*>(input_.get());
+            interleave(src, spectrum);
+            idft(spectrum, dst);
+        }
+
+        // PFFFT does not implement batched transforms, the frames are transformed one after the other. Strided or
+        // misaligned frames are gathered into (and scattered from) aligned scratch buffers.
+        inline void dft_many(const complex_type* src, complex_type* dst, size_type howmany, size_type istride,
+                             size_type idist, size_type ostride, size_type odist) {
+            const batch_layout layout{howmany, istride, idist, nfft_, ostride, odist, nfft_};
+            many(src, dst, layout, [this](const complex_type* in, complex_type* out) { dft(in, out); });
+        }
+
+        inline void idft_many(const complex_type* src, complex_type* dst, size_type howmany, size_type istride,
+                              size_type idist, size_type ostride, size_type odist) {
+            const batch_layout layout{howmany, istride, idist, nfft_, ostride, odist, nfft_};
+            many(src, dst, layout, [this](const complex_type* in, complex_type* out) { idft(in, out); });
+        }
+
+        inline void dft_many(const value_type* src, complex_type* dst, size_type howmany, size_type istride,
+                             size_type idist, size_type ostride, size_type odist) {
+            const batch_layout layout{howmany, istride, idist, nfft_, ostride, odist, nfft_ / 2 + 1};
+            many(src, dst, layout, [this](const value_type* in, complex_type* out) { dft(in, out); });
+        }
+
+        inline void idft_many(const complex_type* src, value_type* dst, size_type howmany, size_type istride,
+                              size_type idist, size_type ostride, size_type odist) {
+            const batch_layout layout{howmany, istride, idist, nfft_ / 2 + 1, ostride, odist, nfft_};
+            many(src, dst, layout, [this](const complex_type* in, value_type* out) { idft(in, out); });
         }
 
         inline void idft_scale(value_type* dst) const {
@@ -213,9 +339,226 @@ namespace edsp { inline namespace spectral {
         }
 
     private:
-        PFFFT_Setup* plan_{nullptr};
-        float* work_{nullptr};
+        struct batch_layout {
+            size_type howmany;
+            size_type istride;
+            size_type idist;
+            size_type icount;
+            size_type ostride;
+            size_type odist;
+            size_type ocount;
+        };
+
+        template <typename I, typename O, typename Operation>
+        void many(const I* src, O* dst, const batch_layout& layout, Operation&& operation) {
+            meta::expects(layout.howmany > 0 && layout.istride > 0 && layout.ostride > 0 && layout.idist >= 0 &&
+                              layout.odist >= 0,
+                          "Invalid layout of the batched transform");
+            for (size_type i = 0; i < layout.howmany; ++i) {
+                const I* in = src + i * layout.idist;
+                O* out      = dst + i * layout.odist;
+                if (layout.istride != 1 || !is_aligned(in, alignment)) {
+                    auto* frame = reinterpret_cast<I*>(input_.get());
+                    for (size_type j = 0; j < layout.icount; ++j) {
+                        frame[j] = in[j * layout.istride];
+                    }
+                    in = frame;
+                }
+
+                if (layout.ostride == 1 && is_aligned(out, alignment)) {
+                    operation(in, out);
+                } else {
+                    auto* frame = reinterpret_cast<O*>(output_.get());
+                    operation(in, frame);
+                    for (size_type j = 0; j < layout.ocount; ++j) {
+                        out[j * layout.ostride] = frame[j];
+                    }
+                }
+            }
+        }
+
+        static void interleave(const split_complex_view<const value_type>& src, complex_type* dst) {
+            for (std::size_t i = 0, size = src.size(); i < size; ++i) {
+                dst[i] = complex_type(src.real()[i], src.imag()[i]);
+            }
+        }
+
+        static void deinterleave(const complex_type* src, const split_complex_view<value_type>& dst) {
+            for (std::size_t i = 0, size = dst.size(); i < size; ++i) {
+                dst.real()[i] = src[i].real();
+                dst.imag()[i] = src[i].imag();
+            }
+        }
+
+        void split_transform(const split_complex_view<const value_type>& src, const split_complex_view<value_type>& dst,
+                             pffft_direction_t direction) {
+            auto* input  = reinterpret_cast<complex_type*>(input_.get());
+            auto* output = reinterpret_cast<complex_type*>(output_.get());
+            interleave(src, input);
+            transform(input, output, direction);
+            deinterleave(output, dst);
+        }
+
+        // PFFFT loads and stores whole SIMD vectors, so misaligned buffers are gathered into (and scattered from) the
+        // aligned scratch buffers. The Bluestein path only accesses them element by element.
+        void transform(const complex_type* src, complex_type* dst, pffft_direction_t direction) {
+            if (bluestein_size_ != 0) {
+                bluestein(src, dst, direction);
+                return;
+            }
+
+            const auto* input = aligned_input(reinterpret_cast<const float*>(src), 2 * nfft_);
+            if (is_aligned(dst, alignment)) {
+                pffft_transform_ordered(complex_setup(), input, reinterpret_cast<float*>(dst), work_.get(), direction);
+            } else {
+                pffft_transform_ordered(complex_setup(), input, output_.get(), work_.get(), direction);
+                std::copy(output_.get(), output_.get() + 2 * nfft_, reinterpret_cast<float*>(dst));
+            }
+        }
+
+        // Returns the given buffer, or a copy in the input scratch buffer if it is misaligned.
+        const float* aligned_input(const float* src, size_type count) {
+            if (is_aligned(src, alignment)) {
+                return src;
+            }
+            std::copy(src, src + count, input_.get());
+            return input_.get();
+        }
+
+        // The DFT is computed as the convolution of the input weighted by the chirp w[n] = exp(-i pi n^2 / N) with
+        // the conjugated chirp, then weighted again by the chirp. The backward transform uses the conjugated input
+        // and output.
+        void bluestein(const complex_type* src, complex_type* dst, pffft_direction_t direction) {
+            auto* buffer         = reinterpret_cast<complex_type*>(bluestein_buffer_.get());
+            const auto conjugate = (direction == PFFFT_BACKWARD);
+            for (size_type i = 0; i < nfft_; ++i) {
+                buffer[i] = (conjugate ? std::conj(src[i]) : src[i]) * chirp_[i];
+            }
+            std::fill(buffer + nfft_, buffer + bluestein_size_, complex_type(0, 0));
+
+            pffft_transform_ordered(bluestein_->setup, bluestein_buffer_.get(), bluestein_buffer_.get(), work_.get(),
+                                    PFFFT_FORWARD);
+            for (size_type i = 0; i < bluestein_size_; ++i) {
+                buffer[i] *= kernel_[i];
+            }
+            pffft_transform_ordered(bluestein_->setup, bluestein_buffer_.get(), bluestein_buffer_.get(), work_.get(),
+                                    PFFFT_BACKWARD);
+
+            for (size_type i = 0; i < nfft_; ++i) {
+                const auto value = buffer[i] * chirp_[i];
+                dst[i]           = conjugate ? std::conj(value) : value;
+            }
+        }
+
+        // The plan, the chirp and the spectrum of the convolution kernel are computed once, in the constructor.
+        void make_bluestein() {
+            bluestein_ = make_plan(PFFFT_COMPLEX, bluestein_size_);
+            meta::expects(!meta::is_null(bluestein_), "Unable to create the FFT plan");
+            bluestein_buffer_ = internal::make_pffft_buffer(2 * static_cast<std::size_t>(bluestein_size_));
+
+            chirp_.resize(static_cast<std::size_t>(nfft_));
+            const auto period = 2 * static_cast<long long>(nfft_);
+            for (size_type i = 0; i < nfft_; ++i) {
+                // Reducing n^2 modulo 2N keeps the phase accurate for large sizes.
+                const auto phase = static_cast<double>((static_cast<long long>(i) * i) % period);
+                chirp_[i] = std::polar(1.0f, static_cast<float>(-math::constants<double>::pi * phase / nfft_));
+            }
+
+            kernel_.assign(static_cast<std::size_t>(bluestein_size_), complex_type(0, 0));
+            kernel_[0] = std::conj(chirp_[0]);
+            for (size_type i = 1; i < nfft_; ++i) {
+                kernel_[i]                   = std::conj(chirp_[i]);
+                kernel_[bluestein_size_ - i] = std::conj(chirp_[i]);
+            }
+            auto* kernel = reinterpret_cast<float*>(kernel_.data());
+            std::copy(kernel, kernel + 2 * bluestein_size_, bluestein_buffer_.get());
+            pffft_transform_ordered(bluestein_->setup, bluestein_buffer_.get(), bluestein_buffer_.get(), work_.get(),
+                                    PFFFT_FORWARD);
+            const auto* spectrum = reinterpret_cast<const complex_type*>(bluestein_buffer_.get());
+            for (size_type i = 0; i < bluestein_size_; ++i) {
+                kernel_[i] = spectrum[i] / static_cast<float>(bluestein_size_);
+            }
+        }
+
+        // Twiddle factors exp(-i pi k / 2N) of the DCT, computed once, in the constructor.
+        void make_dct_twiddles() {
+            dct_twiddles_.resize(static_cast<std::size_t>(nfft_));
+            for (size_type k = 0; k < nfft_; ++k) {
+                const auto angle = -math::constants<double>::pi * k / (2.0 * nfft_);
+                dct_twiddles_[k] = std::polar(1.0f, static_cast<float>(angle));
+            }
+        }
+
+        // Complex and real transforms need different setups, both created lazily in the first call.
+        PFFFT_Setup* complex_setup() {
+            if (meta::is_null(complex_)) {
+                complex_ = make_plan(PFFFT_COMPLEX, nfft_);
+                meta::expects(!meta::is_null(complex_), "Unable to create the FFT plan");
+            }
+            return complex_->setup;
+        }
+
+        PFFFT_Setup* real_setup() {
+            if (meta::is_null(real_)) {
+                real_ = make_plan(PFFFT_REAL, nfft_);
+                meta::expects(!meta::is_null(real_), "Unable to create the FFT plan");
+            }
+            return real_->setup;
+        }
+
+        // A PFFFT setup computes both directions, the kind of the key only identifies the type of the setup.
+        static std::shared_ptr<internal::pffft_setup_holder> make_plan(pffft_transform_t transform, size_type size) {
+            const auto kind = (transform == PFFFT_COMPLEX) ? plan_kind::ComplexForward : plan_kind::RealForward;
+            const plan_key key{sizeof(float), static_cast<std::size_t>(size), kind, planning_rigor::Estimate, false,
+                               true};
+            return plan_cache::instance().acquire<internal::pffft_setup_holder>(
+                key, [&]() -> std::shared_ptr<internal::pffft_setup_holder> {
+                    auto* setup = pffft_new_setup(size, transform);
+                    if (meta::is_null(setup)) {
+                        return nullptr;
+                    }
+                    return std::make_shared<internal::pffft_setup_holder>(setup);
+                });
+        }
+
+        std::shared_ptr<internal::pffft_setup_holder> complex_{nullptr};
+        std::shared_ptr<internal::pffft_setup_holder> real_{nullptr};
+        std::shared_ptr<internal::pffft_setup_holder> bluestein_{nullptr};
+        internal::pffft_buffer work_{nullptr};
+        internal::pffft_buffer input_{nullptr};
+        internal::pffft_buffer output_{nullptr};
+        internal::pffft_buffer spectrum_{nullptr};
+        internal::pffft_buffer bluestein_buffer_{nullptr};
+        std::vector<complex_type> chirp_{};
+        std::vector<complex_type> kernel_{};
+        std::vector<complex_type> dct_twiddles_{};
         size_type nfft_;
+        size_type bluestein_size_;
+        planning_rigor rigor_;
+    };
+
+    /**
+     * @brief PFFFT does not support wisdom, all the operations are no-ops.
+     */
+    template <typename T>
+    struct pffft_wisdom {
+        static bool import_from_file(const std::string&) {
+            return false;
+        }
+
+        static bool export_to_file(const std::string&) {
+            return false;
+        }
+
+        static bool import_from_string(const std::string&) {
+            return false;
+        }
+
+        static std::string export_to_string() {
+            return std::string();
+        }
+
+        static void forget() {}
     };
 
 }}     // namespace edsp::spectral
@@ -0,0 +1,223 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: partitioned_convolver.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_PARTITIONED_CONVOLVER_HPP
+#define EDSP_PARTITIONED_CONVOLVER_HPP
+
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    /**
+     * @class partitioned_convolver
+     * @brief This class implements a Uniformly Partitioned Overlap-Save (UPOLS) convolver, suitable to apply long
+     * impulse responses in real time.
+     *
+     * The kernel is split into partitions of block_size() samples, transformed once in the constructor. The spectra of
+     * the last input blocks are kept in a frequency-domain delay line, so every new block only costs a forward FFT, a
+     * complex multiply-accumulate per partition and an inverse FFT of size 2 * block_size(), whatever the length of the
+     * kernel.
+     *
+     * The latency equals block_size() samples: the input is collected until a block is complete, while the outputs
+     * of the previous block are released.
+     *
+     * All the memory is allocated in the constructor, so processing does not allocate.
+     *
+     * @tparam T Floating point type.
+     * @tparam RAllocator Allocator type of the real buffers, defaults to aligned_allocator<T>.
+     * @tparam CAllocator Allocator type of the complex buffers, defaults to aligned_allocator<std::complex<T>>.
+     * @see block_convolver
+     */
+    template <typename T, typename RAllocator = aligned_allocator<T>,
+              typename CAllocator = aligned_allocator<std::complex<T>>>
+    class partitioned_convolver {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %partitioned_convolver for the kernel stored in the range [first, last).
+         * @param first Input iterator defining the beginning of the kernel.
+         * @param last Input iterator defining the ending of the kernel.
+         * @param block_size Number of samples of every partition, which is also the latency of the convolver.
+         */
+        template <typename InputIt>
+        partitioned_convolver(InputIt first, InputIt last, size_type block_size) :
+            kernel_size_(static_cast<size_type>(std::distance(first, last))),
+            block_(block_size),
+            bins_(block_size + 1),
+            stride_(aligned_stride(bins_)),
+            partitions_((kernel_size_ + block_size - 1) / block_size),
+            kernel_(partitions_ * stride_),
+            delay_line_(partitions_ * stride_, complex_type(0, 0)),
+            accumulator_(bins_),
+            input_(2 * block_size, static_cast<value_type>(0)),
+            output_(2 * block_size, static_cast<value_type>(0)),
+            pending_(block_size, static_cast<value_type>(0)),
+            ready_(block_size, static_cast<value_type>(0)),
+            engine_(2 * block_size) {
+            meta::expects(kernel_size_ > 0, "Not expecting empty kernel");
+            meta::expects(block_size > 0, "Not expecting empty blocks");
+
+            // Every partition is zero-padded to the size of the transform. The scaling of the inverse transform is
+            // folded into the partitions.
+            const auto scaling = static_cast<value_type>(2 * block_);
+            for (size_type p = 0; p < partitions_; ++p) {
+                const auto count = std::min(block_, kernel_size_ - p * block_);
+                auto next        = std::next(first, static_cast<std::ptrdiff_t>(count));
+                std::copy(first, next, std::begin(input_));
+                std::fill(std::begin(input_) + count, std::end(input_), static_cast<value_type>(0));
+                first = next;
+
+                auto* partition = meta::data(kernel_) + p * stride_;
+                engine_.dft(meta::data(input_), partition);
+                for (size_type k = 0; k < bins_; ++k) {
+                    partition[k] /= scaling;
+                }
+            }
+            reset();
+        }
+
+        /**
+         * @brief Returns the number of samples of the kernel.
+         */
+        inline size_type kernel_size() const noexcept {
+            return kernel_size_;
+        }
+
+        /**
+         * @brief Returns the number of samples of every partition.
+         */
+        inline size_type block_size() const noexcept {
+            return block_;
+        }
+
+        /**
+         * @brief Returns the number of partitions of the kernel.
+         */
+        inline size_type partitions() const noexcept {
+            return partitions_;
+        }
+
+        /**
+         * @brief Returns the delay, in samples, between an input sample and its output.
+         */
+        inline size_type latency() const noexcept {
+            return block_;
+        }
+
+        /**
+         * @brief Discards the history of the stream.
+         */
+        inline void reset() {
+            std::fill(std::begin(delay_line_), std::end(delay_line_), complex_type(0, 0));
+            std::fill(std::begin(input_), std::end(input_), static_cast<value_type>(0));
+            std::fill(std::begin(pending_), std::end(pending_), static_cast<value_type>(0));
+            std::fill(std::begin(ready_), std::end(ready_), static_cast<value_type>(0));
+            filled_ = 0;
+            head_   = 0;
+        }
+
+        /**
+         * @brief Convolves the samples in the range [first, last) with the kernel and stores the result in another
+         * range, beginning at d_first.
+         *
+         * The range can have any length. The output is delayed latency() samples with respect to the input.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Output iterator defining the beginning of the destination range.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename InputIt, typename OutputIt>
+        OutputIt process(InputIt first, InputIt last, OutputIt d_first) {
+            while (first != last) {
+                const auto count = std::min(static_cast<size_type>(std::distance(first, last)), block_ - filled_);
+                const auto next  = std::next(first, static_cast<std::ptrdiff_t>(count));
+                std::copy(first, next, std::begin(pending_) + filled_);
+                d_first = std::copy(std::cbegin(ready_) + filled_, std::cbegin(ready_) + filled_ + count, d_first);
+                filled_ += count;
+                first = next;
+
+                if (filled_ == block_) {
+                    convolve();
+                    filled_ = 0;
+                }
+            }
+            return d_first;
+        }
+
+    private:
+        // The partitions and the slots of the delay line are spaced a multiple of the alignment of the backend, so
+        // every spectrum is transformed in place, without copies through the scratch buffers of the engine.
+        static size_type aligned_stride(size_type count) noexcept {
+            const auto step = std::max<size_type>(1, fft_engine<value_type>::alignment() / sizeof(complex_type));
+            return (count + step - 1) / step * step;
+        }
+
+        void convolve() {
+            // Overlap-save: the transform input holds the previous and the current block.
+            std::copy(std::begin(input_) + block_, std::end(input_), std::begin(input_));
+            std::copy(std::cbegin(pending_), std::cend(pending_), std::begin(input_) + block_);
+            engine_.dft(meta::data(input_), meta::data(delay_line_) + head_ * stride_);
+
+            // The p-th partition is applied to the spectrum of the block received p blocks ago.
+            std::fill(std::begin(accumulator_), std::end(accumulator_), complex_type(0, 0));
+            for (size_type p = 0; p < partitions_; ++p) {
+                const auto slot       = (head_ + partitions_ - p) % partitions_;
+                const auto* spectrum  = meta::data(delay_line_) + slot * stride_;
+                const auto* partition = meta::data(kernel_) + p * stride_;
+                for (size_type k = 0; k < bins_; ++k) {
+                    accumulator_[k] += spectrum[k] * partition[k];
+                }
+            }
+            head_ = (head_ + 1) % partitions_;
+
+            engine_.idft(meta::data(accumulator_), meta::data(output_));
+            std::copy(std::cbegin(output_) + block_, std::cend(output_), std::begin(ready_));
+        }
+
+        size_type kernel_size_;
+        size_type block_;
+        size_type bins_;
+        size_type stride_;
+        size_type partitions_;
+        std::vector<complex_type, CAllocator> kernel_;
+        std::vector<complex_type, CAllocator> delay_line_;
+        std::vector<complex_type, CAllocator> accumulator_;
+        std::vector<value_type, RAllocator> input_;
+        std::vector<value_type, RAllocator> output_;
+        std::vector<value_type, RAllocator> pending_;
+        std::vector<value_type, RAllocator> ready_;
+        fft_engine<value_type> engine_;
+        size_type filled_{0};
+        size_type head_{0};
+    };
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_PARTITIONED_CONVOLVER_HPP
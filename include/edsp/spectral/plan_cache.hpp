@@ -0,0 +1,326 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: plan_cache.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_PLAN_CACHE_HPP
+#define EDSP_PLAN_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    /**
+     * @brief The plan_kind enum defines the different transforms an FFT plan is able to compute.
+     */
+    enum class plan_kind {
+        ComplexForward,       /*!< Complex-to-Complex forward transform */
+        ComplexBackward,      /*!< Complex-to-Complex backward transform */
+        RealForward,          /*!< Real-to-Complex forward transform */
+        RealBackward,         /*!< Complex-to-Real backward transform */
+        Hartley,              /*!< Discrete Hartley transform */
+        DctII,                /*!< Discrete Cosine Transform, type II */
+        DctIII,               /*!< Discrete Cosine Transform, type III */
+        SplitComplex,         /*!< Complex-to-Complex forward transform over split-complex buffers */
+        SplitComplexBackward, /*!< Complex-to-Complex backward transform over split-complex buffers */
+        SplitForward,         /*!< Real-to-Complex forward transform into split-complex buffers */
+        SplitBackward         /*!< Complex-to-Real backward transform from split-complex buffers */
+    };
+
+    /**
+     * @brief The planning_rigor enum defines how much effort the backend spends searching for the fastest plan.
+     *
+     * More rigorous planning produces faster plans at the cost of a slower planning stage. The cost can be paid once
+     * per deployment by exporting the accumulated wisdom and importing it at startup.
+     * @see fft_wisdom
+     */
+    enum class planning_rigor {
+        Estimate,  /*!< Heuristic plan, no measurement is performed */
+        Measure,   /*!< Measures the execution time of several algorithms */
+        Patient,   /*!< Like Measure, but considers a wider range of algorithms */
+        Exhaustive /*!< Like Patient, but considers the full set of algorithms */
+    };
+
+    /**
+     * @brief Identifies an FFT plan stored in the %plan_cache.
+     *
+     * Two plans are interchangeable if they share the same precision, size, kind of transform, rigor and number of
+     * threads and if they are executed over buffers with the same memory layout (in-place/out-of-place, alignment
+     * and, for batched plans, the number of transforms and their strides and distances).
+     */
+    struct plan_key {
+        std::size_t precision;   /*!< Size in bytes of the underlying floating point type */
+        std::size_t size;        /*!< Number of samples of the transform */
+        plan_kind kind;          /*!< Kind of transform */
+        planning_rigor rigor;    /*!< Rigor used to create the plan */
+        bool in_place;           /*!< True if the input and output buffers are the same */
+        bool aligned;            /*!< True if the input and output buffers are SIMD aligned */
+        std::size_t howmany{1}; /*!< Number of transforms computed by a batched plan */
+        std::size_t istride{1}; /*!< Distance between two consecutive input samples of the same transform */
+        std::size_t idist{0};   /*!< Distance between the first input sample of two consecutive transforms */
+        std::size_t ostride{1}; /*!< Distance between two consecutive output samples of the same transform */
+        std::size_t odist{0};   /*!< Distance between the first output sample of two consecutive transforms */
+        std::size_t threads{1}; /*!< Number of threads used to execute the plan */
+    };
+
+    inline bool operator==(const plan_key& left, const plan_key& right) noexcept {
+        return left.precision == right.precision && left.size == right.size && left.kind == right.kind &&
+               left.rigor == right.rigor && left.in_place == right.in_place && left.aligned == right.aligned &&
+               left.howmany == right.howmany && left.istride == right.istride && left.idist == right.idist &&
+               left.ostride == right.ostride && left.odist == right.odist && left.threads == right.threads;
+    }
+
+    inline bool operator!=(const plan_key& left, const plan_key& right) noexcept {
+        return !(left == right);
+    }
+
+    namespace internal {
+
+        struct plan_key_hash {
+            std::size_t operator()(const plan_key& key) const noexcept {
+                auto seed = std::hash<std::size_t>{}(key.size);
+                combine(seed, key.precision);
+                combine(seed, static_cast<std::size_t>(key.kind));
+                combine(seed, static_cast<std::size_t>(key.rigor));
+                combine(seed, static_cast<std::size_t>(key.in_place));
+                combine(seed, static_cast<std::size_t>(key.aligned));
+                combine(seed, key.howmany);
+                combine(seed, key.istride);
+                combine(seed, key.idist);
+                combine(seed, key.ostride);
+                combine(seed, key.odist);
+                combine(seed, key.threads);
+                return seed;
+            }
+
+        private:
+            static void combine(std::size_t& seed, std::size_t value) noexcept {
+                seed ^= std::hash<std::size_t>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+        };
+
+    } // namespace internal
+
+    /**
+     * @brief Process-wide, thread-safe cache of FFT plans.
+     *
+     * Creating a plan is usually far more expensive than executing it. The %fft_engine requests its plans to this
+     * cache, so every engine (and every free function built on top of it) of the same size and layout shares the
+     * same plan instead of creating a new one in every call.
+     *
+     * The cache keeps at most capacity() plans and evicts the least recently used one when it is full. Plans
+     * are reference counted: evicting a plan does not invalidate the engines that are still using it.
+     *
+     * Plans are created and destroyed without holding the lock of the cache, so a slow planning stage (e.g. a
+     * measured FFTW plan) only blocks the requests of the same plan, not the lookups of the plans already stored.
+     */
+    class plan_cache {
+    public:
+        using size_type = std::size_t;
+
+        /**
+         * @brief Returns a reference to the global instance of the cache.
+         *
+         * @note The instance is never destroyed, so engines with static storage duration can safely release their
+         * plans at exit.
+         */
+        static plan_cache& instance() {
+            static auto* cache = new plan_cache();
+            return *cache;
+        }
+
+        plan_cache(const plan_cache&) = delete;
+        plan_cache& operator=(const plan_cache&) = delete;
+
+        /**
+         * @brief Returns the plan associated to the given key, creating it with the factory if it is not available.
+         *
+         * If another thread is already creating the plan, the call waits for it instead of creating it again.
+         *
+         * @tparam Plan Type of the stored plan, it should be the same for all the requests sharing a key.
+         * @param key Key identifying the plan.
+         * @param factory Callable object returning a std::shared_ptr<Plan> with a new plan.
+         * @return Shared pointer to the plan, or a null pointer if the factory failed.
+         */
+        template <typename Plan, typename Factory>
+        std::shared_ptr<Plan> acquire(const plan_key& key, Factory&& factory) {
+            std::promise<std::shared_ptr<void>> promise;
+            std::vector<shared_plan> evicted;
+            size_type ticket = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                const auto it = entries_.find(key);
+                if (it != entries_.end()) {
+                    ++hits_;
+                    lru_.splice(lru_.begin(), lru_, it->second.position);
+                    const auto plan = it->second.plan;
+                    lock.unlock();
+                    return std::static_pointer_cast<Plan>(plan.get());
+                }
+
+                // A placeholder is stored before creating the plan, so concurrent requests of the same plan wait for
+                // it instead of creating it again.
+                ++misses_;
+                if (capacity_ > 0) {
+                    ticket = ++tickets_;
+                    lru_.push_front(key);
+                    entries_.emplace(key, entry{promise.get_future().share(), lru_.begin(), ticket});
+                    evict(evicted);
+                }
+            }
+
+            std::shared_ptr<Plan> plan;
+            try {
+                plan = factory();
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+                discard(key, ticket);
+                throw;
+            }
+            promise.set_value(plan);
+            if (!plan) {
+                discard(key, ticket);
+            }
+            return plan;
+        }
+
+        /**
+         * @brief Returns the number of plans stored in the cache.
+         */
+        size_type size() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return entries_.size();
+        }
+
+        /**
+         * @brief Returns the maximum number of plans the cache is able to hold.
+         */
+        size_type capacity() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return capacity_;
+        }
+
+        /**
+         * @brief Updates the maximum number of plans stored in the cache, evicting the least recently used ones.
+         * @param capacity Maximum number of plans. A capacity of zero disables the cache.
+         */
+        void set_capacity(size_type capacity) {
+            std::vector<shared_plan> evicted;
+            std::lock_guard<std::mutex> lock(mutex_);
+            capacity_ = capacity;
+            evict(evicted);
+        }
+
+        /**
+         * @brief Removes all the stored plans.
+         */
+        void clear() {
+            std::unordered_map<plan_key, entry, internal::plan_key_hash> entries;
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.swap(entries);
+            lru_.clear();
+        }
+
+        /**
+         * @brief Returns the number of requests served with an already existing plan.
+         */
+        size_type hits() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return hits_;
+        }
+
+        /**
+         * @brief Returns the number of requests that required the creation of a new plan.
+         */
+        size_type misses() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return misses_;
+        }
+
+        /**
+         * @brief Returns the mutex serializing the creation and destruction of plans.
+         *
+         * Some backends (e.g. FFTW) only guarantee the thread-safety of the execution of a plan, not of the planner.
+         */
+        std::mutex& planner_mutex() noexcept {
+            return planner_mutex_;
+        }
+
+        /**
+         * @brief Resets the hit and miss counters.
+         */
+        void reset_statistics() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            hits_   = 0;
+            misses_ = 0;
+        }
+
+    private:
+        plan_cache() = default;
+
+        using shared_plan = std::shared_future<std::shared_ptr<void>>;
+
+        struct entry {
+            shared_plan plan;
+            std::list<plan_key>::iterator position;
+            size_type ticket;
+        };
+
+        // Destroying a plan may wait for the planner mutex, so the evicted plans are moved to the given buffer and
+        // destroyed by the caller once the lock is released.
+        void evict(std::vector<shared_plan>& evicted) {
+            while (entries_.size() > capacity_) {
+                const auto it = entries_.find(lru_.back());
+                evicted.push_back(std::move(it->second.plan));
+                entries_.erase(it);
+                lru_.pop_back();
+            }
+        }
+
+        // Removes the placeholder of a plan that could not be created, unless it has already been replaced.
+        void discard(const plan_key& key, size_type ticket) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = entries_.find(key);
+            if (it != entries_.end() && it->second.ticket == ticket) {
+                lru_.erase(it->second.position);
+                entries_.erase(it);
+            }
+        }
+
+        mutable std::mutex mutex_;
+        std::mutex planner_mutex_;
+        std::list<plan_key> lru_;
+        std::unordered_map<plan_key, entry, internal::plan_key_hash> entries_;
+        size_type capacity_{128};
+        size_type hits_{0};
+        size_type misses_{0};
+        size_type tickets_{0};
+    };
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_PLAN_CACHE_HPP
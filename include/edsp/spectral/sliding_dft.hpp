@@ -0,0 +1,184 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: sliding_dft.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_SLIDING_DFT_HPP
+#define EDSP_SLIDING_DFT_HPP
+
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/math/constant.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/data.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iterator>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    /**
+     * @class sliding_dft
+     * @brief This class implements a recursive Sliding Discrete Fourier Transform (SDFT), tracking a few bins of the
+     * N-point DFT of the last N samples of a stream.
+     *
+     * Every pushed sample updates the tracked bins with a single complex rotation:
+     *
+     * \f[
+     *  X_k[n] = r e^{j 2 \pi k / N} \left( X_k[n-1] + x[n] - r^N x[n-N] \right)
+     * \f]
+     *
+     * so tracking K bins costs O(K) operations per sample, whatever the window size. The real and imaginary parts of
+     * the bins are stored in separate contiguous arrays, so the update of all the bins is vectorized by the compiler.
+     *
+     * The damping factor r slightly smaller than one (e.g. 0.99999) keeps the recursion stable when the rounding
+     * errors would otherwise accumulate in very long streams. With r equal to one, the bins are equal to the DFT of
+     * the window, indexed from its oldest sample.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the internal buffers, defaults to aligned_allocator<T>.
+     * @see goertzel_bank
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class sliding_dft {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %sliding_dft tracking the bins stored in the range [first, last).
+         * @param first Input iterator defining the beginning of the bin indexes, in the range [0, N).
+         * @param last Input iterator defining the ending of the bin indexes.
+         * @param window_size Number of samples N of the sliding window.
+         * @param damping Damping factor r, in the range (0, 1].
+         */
+        template <typename InputIt>
+        sliding_dft(InputIt first, InputIt last, size_type window_size, value_type damping = 1) :
+            cosine_(static_cast<size_type>(std::distance(first, last))),
+            sine_(cosine_.size()),
+            real_(cosine_.size(), static_cast<value_type>(0)),
+            imag_(cosine_.size(), static_cast<value_type>(0)),
+            delay_line_(window_size, static_cast<value_type>(0)),
+            attenuation_(std::pow(damping, static_cast<value_type>(window_size))) {
+            meta::expects(window_size > 0, "Not expecting empty windows");
+            meta::expects(damping > 0 && damping <= 1, "The damping factor must be in the range (0, 1]");
+            const auto factor = constants<value_type>::two_pi / static_cast<value_type>(window_size);
+            for (size_type k = 0; k < cosine_.size(); ++k, ++first) {
+                const auto bin = static_cast<size_type>(*first);
+                meta::expects(bin < window_size, "The bins must be in the range [0, N)");
+                cosine_[k] = damping * std::cos(factor * static_cast<value_type>(bin));
+                sine_[k]   = damping * std::sin(factor * static_cast<value_type>(bin));
+            }
+        }
+
+        /**
+         * @brief Returns the number of tracked bins.
+         */
+        inline size_type size() const noexcept {
+            return cosine_.size();
+        }
+
+        /**
+         * @brief Returns the number of samples N of the sliding window.
+         */
+        inline size_type window_size() const noexcept {
+            return delay_line_.size();
+        }
+
+        /**
+         * @brief Discards the history of the stream.
+         */
+        inline void reset() {
+            std::fill(std::begin(real_), std::end(real_), static_cast<value_type>(0));
+            std::fill(std::begin(imag_), std::end(imag_), static_cast<value_type>(0));
+            std::fill(std::begin(delay_line_), std::end(delay_line_), static_cast<value_type>(0));
+            head_ = 0;
+        }
+
+        /**
+         * @brief Pushes the samples in the range [first, last) and updates all the tracked bins after every sample.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         */
+        template <typename InputIt>
+        void update(InputIt first, InputIt last) {
+            const auto size = cosine_.size();
+            const auto* c   = meta::data(cosine_);
+            const auto* s   = meta::data(sine_);
+            auto* re        = meta::data(real_);
+            auto* im        = meta::data(imag_);
+            for (; first != last; ++first) {
+                const auto sample  = static_cast<value_type>(*first);
+                const auto delta   = sample - attenuation_ * delay_line_[head_];
+                delay_line_[head_] = sample;
+                head_              = (head_ + 1 == delay_line_.size()) ? 0 : head_ + 1;
+
+                for (size_type k = 0; k < size; ++k) {
+                    const auto x = re[k] + delta;
+                    const auto y = im[k];
+                    re[k]        = c[k] * x - s[k] * y;
+                    im[k]        = s[k] * x + c[k] * y;
+                }
+            }
+        }
+
+        /**
+         * @brief Copies the current value of the tracked bins in another range, beginning at d_first.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for size()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt dft(OutputIt d_first) const {
+            for (size_type k = 0, size = cosine_.size(); k < size; ++k, ++d_first) {
+                *d_first = complex_type(real_[k], imag_[k]);
+            }
+            return d_first;
+        }
+
+        /**
+         * @brief Computes the power of the tracked bins and stores the result in another range, beginning at d_first.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for size()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt power(OutputIt d_first) const {
+            for (size_type k = 0, size = cosine_.size(); k < size; ++k, ++d_first) {
+                *d_first = real_[k] * real_[k] + imag_[k] * imag_[k];
+            }
+            return d_first;
+        }
+
+    private:
+        std::vector<value_type, Allocator> cosine_;
+        std::vector<value_type, Allocator> sine_;
+        std::vector<value_type, Allocator> real_;
+        std::vector<value_type, Allocator> imag_;
+        std::vector<value_type, Allocator> delay_line_;
+        value_type attenuation_;
+        size_type head_{0};
+    };
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_SLIDING_DFT_HPP
@@ -23,6 +23,7 @@
 #define EDSP_SPECTROGRAM_HPP
 
 #include <edsp/spectral/dft.hpp>
+#include <edsp/types/aligned_allocator.hpp>
 #include <edsp/converter/mag2db.hpp>
 #include <edsp/math/numeric.hpp>
 #include <vector>
@@ -48,7 +49,7 @@ namespace edsp { inline namespace spectral {
      * @param scale  Scale to be used in the output
      */
     template <typename InputIt, typename OutputIt,
-              typename Allocator = std::allocator<std::complex<meta::value_type_t<OutputIt>>>>
+              typename Allocator = aligned_allocator<std::complex<meta::value_type_t<OutputIt>>>>
     inline void spectrum(InputIt first, InputIt last, OutputIt d_first) {
         meta::expects(std::distance(first, last) > 0, "Not expecting empty input");
         using value_type = meta::value_type_t<InputIt>;
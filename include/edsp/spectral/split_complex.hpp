@@ -0,0 +1,334 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: split_complex.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_SPLIT_COMPLEX_HPP
+#define EDSP_SPLIT_COMPLEX_HPP
+
+#include <edsp/types/aligned_allocator.hpp>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    namespace internal {
+
+        // Distance between the real and the imaginary parts of a split-complex buffer of the given number of
+        // samples, rounded up so that both arrays are aligned.
+        template <typename T>
+        constexpr std::size_t split_stride(std::size_t count) noexcept {
+            return (count + default_alignment / sizeof(T) - 1) / (default_alignment / sizeof(T)) *
+                   (default_alignment / sizeof(T));
+        }
+
+    } // namespace internal
+
+    /**
+     * @brief Restricts the split-complex overloads of a function to views of floating point samples, so naming its
+     * iterator overloads with explicit template arguments stays unambiguous.
+     */
+    template <typename T>
+    using enable_if_split_value_t = std::enable_if_t<std::is_floating_point<std::remove_cv_t<T>>::value>;
+
+    /**
+     * @class split_magnitude_iterator
+     * @brief Random access iterator computing the magnitude of the samples of a split-complex range on the fly.
+     * @tparam T Floating point type.
+     */
+    template <typename T>
+    class split_magnitude_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = std::remove_cv_t<T>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const value_type*;
+        using reference         = value_type;
+
+        constexpr split_magnitude_iterator(const value_type* real, const value_type* imag) noexcept :
+            real_(real),
+            imag_(imag) {}
+
+        reference operator*() const {
+            return std::sqrt(*real_ * *real_ + *imag_ * *imag_);
+        }
+
+        reference operator[](difference_type n) const {
+            return std::sqrt(real_[n] * real_[n] + imag_[n] * imag_[n]);
+        }
+
+        split_magnitude_iterator& operator++() noexcept {
+            ++real_;
+            ++imag_;
+            return *this;
+        }
+
+        split_magnitude_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        split_magnitude_iterator& operator--() noexcept {
+            --real_;
+            --imag_;
+            return *this;
+        }
+
+        split_magnitude_iterator operator--(int) noexcept {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        split_magnitude_iterator& operator+=(difference_type n) noexcept {
+            real_ += n;
+            imag_ += n;
+            return *this;
+        }
+
+        split_magnitude_iterator& operator-=(difference_type n) noexcept {
+            return *this += -n;
+        }
+
+        friend split_magnitude_iterator operator+(split_magnitude_iterator it, difference_type n) noexcept {
+            return it += n;
+        }
+
+        friend split_magnitude_iterator operator+(difference_type n, split_magnitude_iterator it) noexcept {
+            return it += n;
+        }
+
+        friend split_magnitude_iterator operator-(split_magnitude_iterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const split_magnitude_iterator& left,
+                                         const split_magnitude_iterator& right) noexcept {
+            return left.real_ - right.real_;
+        }
+
+        friend bool operator==(const split_magnitude_iterator& left, const split_magnitude_iterator& right) noexcept {
+            return left.real_ == right.real_;
+        }
+
+        friend bool operator!=(const split_magnitude_iterator& left, const split_magnitude_iterator& right) noexcept {
+            return left.real_ != right.real_;
+        }
+
+        friend bool operator<(const split_magnitude_iterator& left, const split_magnitude_iterator& right) noexcept {
+            return left.real_ < right.real_;
+        }
+
+        friend bool operator>(const split_magnitude_iterator& left, const split_magnitude_iterator& right) noexcept {
+            return right < left;
+        }
+
+        friend bool operator<=(const split_magnitude_iterator& left, const split_magnitude_iterator& right) noexcept {
+            return !(right < left);
+        }
+
+        friend bool operator>=(const split_magnitude_iterator& left, const split_magnitude_iterator& right) noexcept {
+            return !(left < right);
+        }
+
+    private:
+        const value_type* real_;
+        const value_type* imag_;
+    };
+
+    /**
+     * @class split_complex_view
+     * @brief Non-owning view of a complex range stored in split (structure of arrays) format: the real and the
+     * imaginary parts are stored in two separate arrays.
+     *
+     * Most post-processing stages (magnitude, power, log-mel, flux...) work on the real and imaginary parts
+     * separately, so this format vectorizes far better than interleaved std::complex arrays.
+     *
+     * @tparam T Floating point type, const-qualified for read-only views.
+     */
+    template <typename T>
+    class split_complex_view {
+    public:
+        using value_type   = std::remove_cv_t<T>;
+        using complex_type = std::complex<value_type>;
+        using size_type    = std::size_t;
+        using pointer      = T*;
+
+        /**
+         * @brief Creates a view of the given arrays.
+         * @param real Pointer to the array storing the real parts.
+         * @param imag Pointer to the array storing the imaginary parts.
+         * @param size Number of complex samples.
+         */
+        constexpr split_complex_view(pointer real, pointer imag, size_type size) noexcept :
+            real_(real),
+            imag_(imag),
+            size_(size) {}
+
+        /**
+         * @brief Creates a read-only view from a mutable one.
+         */
+        template <typename U, typename = std::enable_if_t<std::is_same<const U, T>::value>>
+        constexpr split_complex_view(const split_complex_view<U>& other) noexcept :
+            real_(other.real()),
+            imag_(other.imag()),
+            size_(other.size()) {}
+
+        /**
+         * @brief Returns a pointer to the array storing the real parts.
+         */
+        constexpr pointer real() const noexcept {
+            return real_;
+        }
+
+        /**
+         * @brief Returns a pointer to the array storing the imaginary parts.
+         */
+        constexpr pointer imag() const noexcept {
+            return imag_;
+        }
+
+        /**
+         * @brief Returns the number of complex samples.
+         */
+        constexpr size_type size() const noexcept {
+            return size_;
+        }
+
+        /**
+         * @brief Returns the i-th complex sample.
+         */
+        complex_type operator[](size_type i) const {
+            return complex_type(real_[i], imag_[i]);
+        }
+
+        /**
+         * @brief Returns an iterator computing the magnitude of the first sample.
+         */
+        split_magnitude_iterator<value_type> magnitude_begin() const noexcept {
+            return split_magnitude_iterator<value_type>(real_, imag_);
+        }
+
+        /**
+         * @brief Returns an iterator computing the magnitude of the sample following the last one.
+         */
+        split_magnitude_iterator<value_type> magnitude_end() const noexcept {
+            return split_magnitude_iterator<value_type>(real_ + size_, imag_ + size_);
+        }
+
+    private:
+        pointer real_;
+        pointer imag_;
+        size_type size_;
+    };
+
+    /**
+     * @class split_complex_buffer
+     * @brief Owning counterpart of %split_complex_view, with both arrays aligned.
+     *
+     * Both arrays are stored in a single block, the imaginary parts starting at the first aligned position after the
+     * real ones. Backends that can only execute a plan over arrays with the planned distance between the real and
+     * the imaginary parts (FFTW) transform these buffers without copying them, as long as the size of the buffer is
+     * the number of samples of the transform.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the arrays, defaults to aligned_allocator<T>.
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class split_complex_buffer {
+    public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+        /**
+         * @brief Creates a buffer of the given number of complex samples, initialized to zero.
+         */
+        explicit split_complex_buffer(size_type size) :
+            data_(2 * internal::split_stride<value_type>(size), static_cast<value_type>(0)),
+            size_(size) {}
+
+        /**
+         * @brief Returns the number of complex samples.
+         */
+        size_type size() const noexcept {
+            return size_;
+        }
+
+        /**
+         * @brief Returns a mutable view of the buffer.
+         */
+        split_complex_view<value_type> view() noexcept {
+            return split_complex_view<value_type>(data_.data(), data_.data() + data_.size() / 2, size_);
+        }
+
+        /**
+         * @brief Returns a read-only view of the buffer.
+         */
+        split_complex_view<const value_type> view() const noexcept {
+            return split_complex_view<const value_type>(data_.data(), data_.data() + data_.size() / 2, size_);
+        }
+
+    private:
+        std::vector<value_type, Allocator> data_;
+        size_type size_;
+    };
+
+    /**
+     * @brief Computes the magnitude of the samples of a split-complex range and stores the result in another range,
+     * beginning at d_first.
+     * @param spectrum View of the split-complex range.
+     * @param d_first Output iterator defining the beginning of the destination range.
+     * @returns Output iterator to the element in the destination range, one past the last element copied.
+     */
+    template <typename T, typename OutputIt>
+    inline OutputIt split_magnitude(const split_complex_view<T>& spectrum, OutputIt d_first) {
+        const auto* real = spectrum.real();
+        const auto* imag = spectrum.imag();
+        for (std::size_t i = 0, size = spectrum.size(); i < size; ++i, ++d_first) {
+            *d_first = std::sqrt(real[i] * real[i] + imag[i] * imag[i]);
+        }
+        return d_first;
+    }
+
+    /**
+     * @brief Computes the power (squared magnitude) of the samples of a split-complex range and stores the result in
+     * another range, beginning at d_first.
+     * @param spectrum View of the split-complex range.
+     * @param d_first Output iterator defining the beginning of the destination range.
+     * @returns Output iterator to the element in the destination range, one past the last element copied.
+     */
+    template <typename T, typename OutputIt>
+    inline OutputIt split_power(const split_complex_view<T>& spectrum, OutputIt d_first) {
+        const auto* real = spectrum.real();
+        const auto* imag = spectrum.imag();
+        for (std::size_t i = 0, size = spectrum.size(); i < size; ++i, ++d_first) {
+            *d_first = real[i] * real[i] + imag[i] * imag[i];
+        }
+        return d_first;
+    }
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_SPLIT_COMPLEX_HPP
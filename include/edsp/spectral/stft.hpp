@@ -0,0 +1,325 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: stft.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_STFT_HPP
+#define EDSP_STFT_HPP
+
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/windowing/hanning.hpp>
+#include <edsp/meta/expects.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    /**
+     * @class stft
+     * @brief This class implements a streaming Short-Time Fourier Transform (STFT).
+     *
+     * The input signal is pushed in chunks of arbitrary length. Every time frame_size() samples are available, they
+     * are weighted by the analysis window and transformed with a Real-to-Complex FFT, then the analysis position
+     * moves forward hop_size() samples. The samples that do not complete a frame are kept until the next call.
+     *
+     * The computed spectra are stored in a caller-provided row-major matrix, one frame of bins() complex samples per
+     * row. The rows that do not satisfy fft_engine::alignment() are transformed into an aligned buffer and copied
+     * out. All the memory is allocated in the constructor, so processing does not allocate.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the internal buffers, defaults to aligned_allocator<T>.
+     * @see istft
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class stft {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %stft with a Hann analysis window.
+         * @param frame_size Number of samples of every analysis frame.
+         * @param hop_size Number of samples between the beginning of two consecutive frames.
+         */
+        stft(size_type frame_size, size_type hop_size) :
+            window_(frame_size),
+            buffer_(frame_size, static_cast<value_type>(0)),
+            frame_(frame_size),
+            spectrum_(make_fft_size(frame_size)),
+            engine_(frame_size),
+            hop_(hop_size) {
+            meta::expects(hop_size > 0 && hop_size <= frame_size, "The hop size must be in the range [1, frame_size]");
+            windowing::hanning(std::begin(window_), std::end(window_));
+        }
+
+        /**
+         * @brief Creates a %stft with the analysis window stored in the range [first, last).
+         * @param first Input iterator defining the beginning of the window.
+         * @param last Input iterator defining the ending of the window. The frame size is the length of the window.
+         * @param hop_size Number of samples between the beginning of two consecutive frames.
+         */
+        template <typename InputIt>
+        stft(InputIt first, InputIt last, size_type hop_size) :
+            window_(first, last),
+            buffer_(window_.size(), static_cast<value_type>(0)),
+            frame_(window_.size()),
+            spectrum_(make_fft_size(window_.size())),
+            engine_(window_.size()),
+            hop_(hop_size) {
+            meta::expects(hop_size > 0 && hop_size <= window_.size(),
+                          "The hop size must be in the range [1, frame_size]");
+        }
+
+        /**
+         * @brief Returns the number of samples of every analysis frame.
+         */
+        inline size_type frame_size() const noexcept {
+            return window_.size();
+        }
+
+        /**
+         * @brief Returns the number of samples between the beginning of two consecutive frames.
+         */
+        inline size_type hop_size() const noexcept {
+            return hop_;
+        }
+
+        /**
+         * @brief Returns the number of complex samples of every computed spectrum.
+         */
+        inline size_type bins() const noexcept {
+            return make_fft_size(window_.size());
+        }
+
+        /**
+         * @brief Returns the number of frames computed if the given number of samples is pushed.
+         *
+         * Use it to size the output matrix: it should have at least frames(N) * bins() elements.
+         * @param samples Number of samples to be pushed.
+         * @returns Number of complete frames.
+         */
+        inline size_type frames(size_type samples) const noexcept {
+            const auto available = filled_ + samples;
+            return (available < window_.size()) ? 0 : (available - window_.size()) / hop_ + 1;
+        }
+
+        /**
+         * @brief Discards the buffered samples.
+         */
+        inline void reset() {
+            std::fill(std::begin(buffer_), std::end(buffer_), static_cast<value_type>(0));
+            filled_ = 0;
+        }
+
+        /**
+         * @brief Pushes the samples in the range [first, last) and computes the spectrum of every completed frame.
+         *
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         * @param d_first Pointer to the beginning of the output matrix, with room for frames(N) * bins() elements.
+         * @returns Number of computed frames.
+         */
+        template <typename InputIt>
+        size_type process(InputIt first, InputIt last, complex_type* d_first) {
+            const auto size = window_.size();
+            size_type computed{0};
+            while (first != last) {
+                const auto missing   = static_cast<std::ptrdiff_t>(size - filled_);
+                const auto available = std::distance(first, last);
+                const auto count     = std::min(missing, static_cast<std::ptrdiff_t>(available));
+                auto next            = std::next(first, count);
+                std::copy(first, next, std::begin(buffer_) + filled_);
+                filled_ += static_cast<size_type>(count);
+                first = next;
+
+                if (filled_ == size) {
+                    std::transform(std::cbegin(buffer_), std::cend(buffer_), std::cbegin(window_), std::begin(frame_),
+                                   std::multiplies<value_type>());
+                    auto* row = d_first + computed * bins();
+                    if (engine_.is_aligned(row)) {
+                        engine_.dft(frame_.data(), row);
+                    } else {
+                        engine_.dft(frame_.data(), spectrum_.data());
+                        std::copy(std::cbegin(spectrum_), std::cend(spectrum_), row);
+                    }
+                    std::copy(std::begin(buffer_) + hop_, std::end(buffer_), std::begin(buffer_));
+                    filled_ = size - hop_;
+                    ++computed;
+                }
+            }
+            return computed;
+        }
+
+    private:
+        std::vector<value_type, Allocator> window_;
+        std::vector<value_type, Allocator> buffer_;
+        std::vector<value_type, Allocator> frame_;
+        std::vector<complex_type, typename std::allocator_traits<Allocator>::template rebind_alloc<complex_type>>
+            spectrum_;
+        fft_engine<value_type> engine_;
+        size_type hop_;
+        size_type filled_{0};
+    };
+
+    /**
+     * @class istft
+     * @brief This class implements a streaming Inverse Short-Time Fourier Transform, the counterpart of %stft.
+     *
+     * Every frame is transformed back to the time domain, weighted by the synthesis window and accumulated with the
+     * previous ones (Weighted Overlap-Add). Every frame completes hop_size() output samples, normalized by the sum of
+     * the overlapped products of the analysis and synthesis windows, so a signal analyzed by a %stft with the same
+     * window and hop size is perfectly reconstructed, except for the first frame_size() - hop_size() samples, where
+     * not all the frames are overlapped yet.
+     *
+     * All the memory is allocated in the constructor, so processing does not allocate.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the internal buffers, defaults to aligned_allocator<T>.
+     * @see stft
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class istft {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates an %istft with a Hann window.
+         * @param frame_size Number of samples of every frame.
+         * @param hop_size Number of samples between the beginning of two consecutive frames.
+         */
+        istft(size_type frame_size, size_type hop_size) :
+            window_(frame_size),
+            accumulator_(frame_size, static_cast<value_type>(0)),
+            frame_(frame_size),
+            normalization_(hop_size),
+            engine_(frame_size),
+            hop_(hop_size) {
+            meta::expects(hop_size > 0 && hop_size <= frame_size, "The hop size must be in the range [1, frame_size]");
+            windowing::hanning(std::begin(window_), std::end(window_));
+            normalize();
+        }
+
+        /**
+         * @brief Creates an %istft with the window stored in the range [first, last).
+         *
+         * The window is used both as analysis and as synthesis window, it should be the one used by the %stft.
+         * @param first Input iterator defining the beginning of the window.
+         * @param last Input iterator defining the ending of the window. The frame size is the length of the window.
+         * @param hop_size Number of samples between the beginning of two consecutive frames.
+         */
+        template <typename InputIt>
+        istft(InputIt first, InputIt last, size_type hop_size) :
+            window_(first, last),
+            accumulator_(window_.size(), static_cast<value_type>(0)),
+            frame_(window_.size()),
+            normalization_(hop_size),
+            engine_(window_.size()),
+            hop_(hop_size) {
+            meta::expects(hop_size > 0 && hop_size <= window_.size(),
+                          "The hop size must be in the range [1, frame_size]");
+            normalize();
+        }
+
+        /**
+         * @brief Returns the number of samples of every frame.
+         */
+        inline size_type frame_size() const noexcept {
+            return window_.size();
+        }
+
+        /**
+         * @brief Returns the number of samples between the beginning of two consecutive frames.
+         */
+        inline size_type hop_size() const noexcept {
+            return hop_;
+        }
+
+        /**
+         * @brief Returns the number of complex samples of every input spectrum.
+         */
+        inline size_type bins() const noexcept {
+            return make_fft_size(window_.size());
+        }
+
+        /**
+         * @brief Discards the accumulated samples.
+         */
+        inline void reset() {
+            std::fill(std::begin(accumulator_), std::end(accumulator_), static_cast<value_type>(0));
+        }
+
+        /**
+         * @brief Resynthesizes the given frames and stores the completed samples in the range beginning at d_first.
+         *
+         * @param frames Pointer to the beginning of the input matrix, storing count * bins() elements.
+         * @param count Number of frames.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for
+         * count * hop_size() samples.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt process(const complex_type* frames, size_type count, OutputIt d_first) {
+            const auto size = window_.size();
+            for (size_type i = 0; i < count; ++i) {
+                engine_.idft(frames + i * bins(), frame_.data());
+                engine_.idft_scale(frame_.data());
+                for (size_type j = 0; j < size; ++j) {
+                    accumulator_[j] += frame_[j] * window_[j];
+                }
+
+                for (size_type j = 0; j < hop_; ++j, ++d_first) {
+                    *d_first = accumulator_[j] * normalization_[j];
+                }
+                std::copy(std::begin(accumulator_) + hop_, std::end(accumulator_), std::begin(accumulator_));
+                std::fill(std::end(accumulator_) - hop_, std::end(accumulator_), static_cast<value_type>(0));
+            }
+            return d_first;
+        }
+
+    private:
+        // Stores the inverse of the sum of the squared windows overlapped in every output sample.
+        void normalize() {
+            std::fill(std::begin(normalization_), std::end(normalization_), static_cast<value_type>(0));
+            for (size_type j = 0; j < window_.size(); ++j) {
+                normalization_[j % hop_] += window_[j] * window_[j];
+            }
+            for (auto& factor : normalization_) {
+                factor = (factor > std::numeric_limits<value_type>::epsilon()) ? 1 / factor : 0;
+            }
+        }
+
+        std::vector<value_type, Allocator> window_;
+        std::vector<value_type, Allocator> accumulator_;
+        std::vector<value_type, Allocator> frame_;
+        std::vector<value_type, Allocator> normalization_;
+        fft_engine<value_type> engine_;
+        size_type hop_;
+    };
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_STFT_HPP
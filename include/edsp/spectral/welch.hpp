@@ -0,0 +1,385 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: welch.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_WELCH_HPP
+#define EDSP_WELCH_HPP
+
+#include <edsp/spectral/fft_engine.hpp>
+#include <edsp/types/aligned_allocator.hpp>
+#include <edsp/windowing/hanning.hpp>
+#include <edsp/meta/expects.hpp>
+#include <edsp/meta/is_iterator.hpp>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace edsp { inline namespace spectral {
+
+    /**
+     * @brief The detrend_type enum defines the trend removed from every segment before computing its spectrum.
+     */
+    enum class detrend_type {
+        None,     /*!< The segments are not modified */
+        Constant, /*!< The mean of every segment is removed */
+        Linear    /*!< The least-squares line fitting every segment is removed */
+    };
+
+    /**
+     * @brief The psd_scaling enum defines the units of a power spectral estimate.
+     */
+    enum class psd_scaling {
+        Density, /*!< Power spectral density, in V**2/Hz if the input is in V */
+        Spectrum /*!< Power spectrum, in V**2 if the input is in V */
+    };
+
+    /**
+     * @brief The psd_sides enum defines which frequencies are stored in a power spectral estimate of a real signal.
+     */
+    enum class psd_sides {
+        OneSided, /*!< Only the non-negative frequencies, the power of the negative ones is folded into them */
+        TwoSided  /*!< All the frequencies, in the order of the FFT */
+    };
+
+    /**
+     * @class welch
+     * @brief This class estimates the power spectral density of a stream with the Welch's method (averaged modified
+     * periodograms).
+     *
+     * The stream is divided in overlapping segments, every segment is detrended and weighted by the window, and the
+     * periodograms of all the segments are averaged. The input is pushed in chunks of arbitrary length, and only the
+     * running sum of the periodograms is kept, so arbitrarily long recordings are summarized in constant memory.
+     *
+     * The completed segments are transformed in batches with a single batched Real-to-Complex plan. All the memory is
+     * allocated in the constructor, so processing does not allocate.
+     *
+     * @tparam T Floating point type.
+     * @tparam Allocator Allocator type of the internal buffers, defaults to aligned_allocator<T>.
+     * @see stft
+     */
+    template <typename T, typename Allocator = aligned_allocator<T>>
+    class welch {
+    public:
+        using value_type   = T;
+        using complex_type = std::complex<T>;
+        using size_type    = std::size_t;
+
+        /**
+         * @brief Creates a %welch estimator with a Hann window.
+         * @param segment_size Number of samples of every segment.
+         * @param overlap Number of samples shared by two consecutive segments.
+         * @param sample_rate Sampling frequency of the stream.
+         * @param detrend Trend removed from every segment.
+         * @param scaling Units of the estimate.
+         * @param sides Frequencies stored in the estimate.
+         */
+        welch(size_type segment_size, size_type overlap, value_type sample_rate = 1,
+              detrend_type detrend = detrend_type::Constant, psd_scaling scaling = psd_scaling::Density,
+              psd_sides sides = psd_sides::OneSided) :
+            window_(segment_size),
+            buffer_(segment_size, static_cast<value_type>(0)),
+            frames_(batch * frame_stride()),
+            spectra_(batch * spectrum_stride()),
+            accumulator_(make_fft_size(segment_size), static_cast<value_type>(0)),
+            engine_(segment_size),
+            overlap_(overlap),
+            sample_rate_(sample_rate),
+            detrend_(detrend),
+            scaling_(scaling),
+            sides_(sides) {
+            windowing::hanning(std::begin(window_), std::end(window_));
+            initialize();
+        }
+
+        /**
+         * @brief Creates a %welch estimator with the window stored in the range [first, last).
+         * @param first Input iterator defining the beginning of the window.
+         * @param last Input iterator defining the ending of the window. The segment size is the length of the window.
+         * @param overlap Number of samples shared by two consecutive segments.
+         * @param sample_rate Sampling frequency of the stream.
+         * @param detrend Trend removed from every segment.
+         * @param scaling Units of the estimate.
+         * @param sides Frequencies stored in the estimate.
+         */
+        template <typename InputIt, typename = typename std::enable_if<meta::is_iterator<InputIt>::value>::type>
+        welch(InputIt first, InputIt last, size_type overlap, value_type sample_rate = 1,
+              detrend_type detrend = detrend_type::Constant, psd_scaling scaling = psd_scaling::Density,
+              psd_sides sides = psd_sides::OneSided) :
+            window_(first, last),
+            buffer_(window_.size(), static_cast<value_type>(0)),
+            frames_(batch * frame_stride()),
+            spectra_(batch * spectrum_stride()),
+            accumulator_(make_fft_size(window_.size()), static_cast<value_type>(0)),
+            engine_(window_.size()),
+            overlap_(overlap),
+            sample_rate_(sample_rate),
+            detrend_(detrend),
+            scaling_(scaling),
+            sides_(sides) {
+            initialize();
+        }
+
+        /**
+         * @brief Returns the number of samples of every segment.
+         */
+        inline size_type segment_size() const noexcept {
+            return window_.size();
+        }
+
+        /**
+         * @brief Returns the number of samples shared by two consecutive segments.
+         */
+        inline size_type overlap() const noexcept {
+            return overlap_;
+        }
+
+        /**
+         * @brief Returns the sampling frequency of the stream.
+         */
+        inline value_type sample_rate() const noexcept {
+            return sample_rate_;
+        }
+
+        /**
+         * @brief Returns the number of frequencies of the estimate.
+         */
+        inline size_type bins() const noexcept {
+            return (sides_ == psd_sides::OneSided) ? accumulator_.size() : window_.size();
+        }
+
+        /**
+         * @brief Returns the number of segments averaged so far.
+         */
+        inline size_type segments() const noexcept {
+            return segments_;
+        }
+
+        /**
+         * @brief Discards the buffered samples and the accumulated periodograms.
+         */
+        inline void reset() {
+            std::fill(std::begin(buffer_), std::end(buffer_), static_cast<value_type>(0));
+            std::fill(std::begin(accumulator_), std::end(accumulator_), static_cast<value_type>(0));
+            filled_   = 0;
+            segments_ = 0;
+        }
+
+        /**
+         * @brief Pushes the samples in the range [first, last) and accumulates the periodogram of every completed
+         * segment.
+         * @param first Input iterator defining the beginning of the input range.
+         * @param last Input iterator defining the ending of the input range.
+         */
+        template <typename InputIt>
+        void process(InputIt first, InputIt last) {
+            const auto size = window_.size();
+            size_type pending{0};
+            while (first != last) {
+                const auto missing   = static_cast<std::ptrdiff_t>(size - filled_);
+                const auto available = std::distance(first, last);
+                const auto count     = std::min(missing, static_cast<std::ptrdiff_t>(available));
+                auto next            = std::next(first, count);
+                std::copy(first, next, std::begin(buffer_) + filled_);
+                filled_ += static_cast<size_type>(count);
+                first = next;
+
+                if (filled_ == size) {
+                    prepare(meta::data(frames_) + pending * frame_stride());
+                    std::copy(std::begin(buffer_) + hop_size(), std::end(buffer_), std::begin(buffer_));
+                    filled_ = overlap_;
+                    if (++pending == batch) {
+                        accumulate(pending);
+                        pending = 0;
+                    }
+                }
+            }
+            accumulate(pending);
+        }
+
+        /**
+         * @brief Computes the average of the accumulated periodograms and stores the result in another range,
+         * beginning at d_first.
+         *
+         * The estimate is null until a segment has been completed.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for bins()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt estimate(OutputIt d_first) const {
+            const auto size   = window_.size();
+            const auto half   = accumulator_.size();
+            const auto factor = (segments_ == 0) ? static_cast<value_type>(0)
+                                                 : scale_ / static_cast<value_type>(segments_);
+            if (sides_ == psd_sides::TwoSided) {
+                for (size_type i = 0; i < size; ++i, ++d_first) {
+                    *d_first = accumulator_[std::min(i, size - i)] * factor;
+                }
+                return d_first;
+            }
+
+            // The power of the negative frequencies is folded into the positive ones, except for the DC and the
+            // Nyquist components, which do not have a counterpart.
+            const auto nyquist = (size % 2 == 0) ? half - 1 : half;
+            for (size_type i = 0; i < half; ++i, ++d_first) {
+                const auto folded = (i == 0 || i == nyquist) ? 1 : 2;
+                *d_first          = accumulator_[i] * factor * static_cast<value_type>(folded);
+            }
+            return d_first;
+        }
+
+        /**
+         * @brief Computes the frequencies, in the units of the sample rate, of the bins of the estimate and stores
+         * the result in another range, beginning at d_first.
+         * @param d_first Output iterator defining the beginning of the destination range, with room for bins()
+         * elements.
+         * @returns Output iterator to the element in the destination range, one past the last element copied.
+         */
+        template <typename OutputIt>
+        OutputIt frequencies(OutputIt d_first) const {
+            const auto size       = window_.size();
+            const auto resolution = sample_rate_ / static_cast<value_type>(size);
+            for (size_type i = 0, count = bins(); i < count; ++i, ++d_first) {
+                const auto negative = sides_ == psd_sides::TwoSided && i >= (size + 1) / 2;
+                const auto bin      = negative ? static_cast<value_type>(i) - static_cast<value_type>(size)
+                                               : static_cast<value_type>(i);
+                *d_first       = bin * resolution;
+            }
+            return d_first;
+        }
+
+    private:
+        // Number of segments transformed with a single call to the batched plan.
+        static constexpr size_type batch = 8;
+
+        inline size_type hop_size() const noexcept {
+            return window_.size() - overlap_;
+        }
+
+        // The segments and their spectra are spaced a multiple of the alignment of the backend, so every one of them
+        // is transformed in place, also when the remainder of a batch is transformed one by one.
+        template <typename U>
+        static size_type aligned_stride(size_type count) noexcept {
+            const auto step = std::max<size_type>(1, fft_engine<value_type>::alignment() / sizeof(U));
+            return (count + step - 1) / step * step;
+        }
+
+        inline size_type frame_stride() const noexcept {
+            return aligned_stride<value_type>(window_.size());
+        }
+
+        inline size_type spectrum_stride() const noexcept {
+            return aligned_stride<complex_type>(make_fft_size(window_.size()));
+        }
+
+        void initialize() {
+            const auto size = window_.size();
+            meta::expects(size > 0, "Not expecting empty segments");
+            meta::expects(overlap_ < size, "The overlap must be smaller than the segment size");
+            meta::expects(sample_rate_ > 0, "The sample rate must be positive");
+
+            const auto sum     = std::accumulate(std::cbegin(window_), std::cend(window_), static_cast<value_type>(0));
+            const auto squared = std::inner_product(std::cbegin(window_), std::cend(window_), std::cbegin(window_),
+                                                    static_cast<value_type>(0));
+            scale_ = (scaling_ == psd_scaling::Density) ? 1 / (sample_rate_ * squared) : 1 / (sum * sum);
+
+            // Centered time axis used to fit the linear trend.
+            const auto center = static_cast<value_type>(size - 1) / 2;
+            variance_         = 0;
+            for (size_type i = 0; i < size; ++i) {
+                const auto t = static_cast<value_type>(i) - center;
+                variance_ += t * t;
+            }
+        }
+
+        // Detrends and windows the buffered segment.
+        void prepare(value_type* frame) const {
+            const auto size   = window_.size();
+            const auto center = static_cast<value_type>(size - 1) / 2;
+            auto mean         = static_cast<value_type>(0);
+            auto slope        = static_cast<value_type>(0);
+            if (detrend_ != detrend_type::None) {
+                mean = std::accumulate(std::cbegin(buffer_), std::cend(buffer_), static_cast<value_type>(0)) /
+                       static_cast<value_type>(size);
+            }
+            if (detrend_ == detrend_type::Linear && variance_ > 0) {
+                for (size_type i = 0; i < size; ++i) {
+                    slope += (static_cast<value_type>(i) - center) * buffer_[i];
+                }
+                slope /= variance_;
+            }
+
+            for (size_type i = 0; i < size; ++i) {
+                const auto trend = mean + slope * (static_cast<value_type>(i) - center);
+                frame[i]         = (buffer_[i] - trend) * window_[i];
+            }
+        }
+
+        // Transforms the prepared segments and accumulates their periodograms.
+        void accumulate(size_type count) {
+            if (count == 0) {
+                return;
+            }
+
+            const auto half          = accumulator_.size();
+            const auto frame_dist    = frame_stride();
+            const auto spectrum_dist = spectrum_stride();
+            if (count == batch) {
+                engine_.dft_many(meta::data(frames_), meta::data(spectra_), batch, 1, frame_dist, 1, spectrum_dist);
+            } else {
+                for (size_type i = 0; i < count; ++i) {
+                    engine_.dft(meta::data(frames_) + i * frame_dist, meta::data(spectra_) + i * spectrum_dist);
+                }
+            }
+
+            for (size_type i = 0; i < count; ++i) {
+                const auto* spectrum = meta::data(spectra_) + i * spectrum_dist;
+                for (size_type k = 0; k < half; ++k) {
+                    accumulator_[k] += std::norm(spectrum[k]);
+                }
+            }
+            segments_ += count;
+        }
+
+        std::vector<value_type, Allocator> window_;
+        std::vector<value_type, Allocator> buffer_;
+        std::vector<value_type, Allocator> frames_;
+        std::vector<complex_type, typename std::allocator_traits<Allocator>::template rebind_alloc<complex_type>>
+            spectra_;
+        std::vector<value_type, Allocator> accumulator_;
+        fft_engine<value_type> engine_;
+        size_type overlap_;
+        value_type sample_rate_;
+        detrend_type detrend_;
+        psd_scaling scaling_;
+        psd_sides sides_;
+        value_type scale_{1};
+        value_type variance_{0};
+        size_type filled_{0};
+        size_type segments_{0};
+    };
+
+}} // namespace edsp::spectral
+
+#endif //EDSP_WELCH_HPP
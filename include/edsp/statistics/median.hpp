@@ -23,9 +23,10 @@
 #define EDSP_STATISTICAL_MEDIANT_HPP
 
 #include <edsp/meta/iterator.hpp>
-#include <edsp/meta/unused.hpp>
+#include <edsp/meta/expects.hpp>
 #include <algorithm>
-#include <numeric>
+#include <iterator>
+#include <vector>
 
 namespace edsp { namespace statistics {
 
@@ -36,16 +37,26 @@ namespace edsp { namespace statistics {
      * If there is an odd number of numbers, the middle one is picked. If there is an even number of observations,
      * then there is no single middle value; the median is then usually defined to be the mean of the two middle values
      *
+     * The elements are copied and the middle ones are found with a selection algorithm, in linear time on average.
+     *
      * @param first Forward iterator defining the begin of the range to examine.
      * @param last Forward iterator defining the end of the range to examine.
      * @returns The median of the input range.
      */
     template <typename ForwardIt>
-    constexpr meta::value_type_t<ForwardIt> median(ForwardIt first, ForwardIt last) {
-        // TODO: implement the median: do not use sorting algorithm.
-        meta::unused(first);
-        meta::unused(last);
-        return 0;
+    meta::value_type_t<ForwardIt> median(ForwardIt first, ForwardIt last) {
+        using value_type = meta::value_type_t<ForwardIt>;
+        meta::expects(first != last, "Not expecting empty input");
+        std::vector<value_type> data(first, last);
+        const auto half   = data.size() / 2;
+        const auto middle = std::begin(data) + static_cast<std::ptrdiff_t>(half);
+        std::nth_element(std::begin(data), middle, std::end(data));
+        if (data.size() % 2 != 0) {
+            return *middle;
+        }
+        // The elements before the middle one are not greater than it, the largest of them is the other middle value.
+        const auto lower = *std::max_element(std::begin(data), middle);
+        return (lower + *middle) / static_cast<value_type>(2);
     }
 
 }} // namespace edsp::statistics
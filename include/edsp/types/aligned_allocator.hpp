@@ -0,0 +1,148 @@
+/*
+* eDSP, A cross-platform Digital Signal Processing library written in modern C++.
+* Copyright (C) 2019 Mohammed Boujemaoui Boulaghmoudi, All rights reserved.
+*
+* This program is free software: you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the Free
+* Software Foundation, either version 3 of the License, or (at your option)
+* any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along width
+* this program.  If not, see <http://www.gnu.org/licenses/>
+*
+* Filename: aligned_allocator.hpp
+* Author: Mohammed Boujemaoui
+* Date: 17/10/26
+*/
+
+#ifndef EDSP_ALIGNED_ALLOCATOR_HPP
+#define EDSP_ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <vector>
+
+#if defined(_WIN32) || defined(_WIN64)
+#    include <malloc.h>
+#endif
+
+namespace edsp { inline namespace types {
+
+    /**
+     * @brief Default alignment, in bytes, of the aligned buffers.
+     *
+     * It satisfies the requirements of the SIMD instruction sets used by the FFT backends (SSE, AVX and AVX-512).
+     */
+    constexpr std::size_t default_alignment = 64;
+
+    /**
+     * @brief Checks if the given pointer is aligned to the given number of bytes.
+     * @param p Pointer to evaluate.
+     * @param alignment Alignment in bytes, it should be a power of two.
+     * @returns true if the pointer is aligned, false otherwise.
+     */
+    inline bool is_aligned(const void* p, std::size_t alignment = default_alignment) noexcept {
+        return (reinterpret_cast<std::uintptr_t>(p) & (alignment - 1)) == 0;
+    }
+
+    /**
+     * @class aligned_allocator
+     * @brief STL compliant allocator returning memory aligned to the given number of bytes.
+     *
+     * The FFT backends select faster SIMD code paths when their buffers are aligned, use this allocator in the
+     * containers passed to them.
+     *
+     * @tparam T Type of element.
+     * @tparam Alignment Alignment in bytes, it should be a power of two.
+     */
+    template <typename T, std::size_t Alignment = default_alignment>
+    class aligned_allocator {
+        static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "The alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "The alignment must satisfy the alignment of the type");
+
+    public:
+        using value_type      = T;
+        using pointer         = T*;
+        using const_pointer   = const T*;
+        using reference       = T&;
+        using const_reference = const T&;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template <typename U>
+        struct rebind {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+        aligned_allocator() noexcept = default;
+
+        template <typename U>
+        aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+        /**
+         * @brief Allocates uninitialized storage for n elements.
+         * @param n Number of elements.
+         * @returns Pointer to the first element of the storage.
+         * @throws std::bad_alloc if the allocation fails.
+         */
+        pointer allocate(size_type n) {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+                throw std::bad_alloc();
+            }
+            const auto bytes = (n == 0) ? Alignment : n * sizeof(T);
+#if defined(_WIN32) || defined(_WIN64)
+            void* p = _aligned_malloc(bytes, Alignment);
+            if (p == nullptr) {
+                throw std::bad_alloc();
+            }
+#else
+            void* p = nullptr;
+            if (posix_memalign(&p, Alignment, bytes) != 0) {
+                throw std::bad_alloc();
+            }
+#endif
+            return static_cast<pointer>(p);
+        }
+
+        /**
+         * @brief Deallocates the storage pointed by p, obtained from a previous call to allocate.
+         * @param p Pointer to the storage.
+         */
+        void deallocate(pointer p, size_type) noexcept {
+#if defined(_WIN32) || defined(_WIN64)
+            _aligned_free(p);
+#else
+            std::free(p);
+#endif
+        }
+    };
+
+    template <typename T, typename U, std::size_t Alignment>
+    constexpr bool operator==(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) noexcept {
+        return true;
+    }
+
+    template <typename T, typename U, std::size_t Alignment>
+    constexpr bool operator!=(const aligned_allocator<T, Alignment>&, const aligned_allocator<U, Alignment>&) noexcept {
+        return false;
+    }
+
+    /**
+     * @brief Contiguous buffer whose elements are aligned to the given number of bytes.
+     * @tparam T Type of element.
+     * @tparam Alignment Alignment in bytes, it should be a power of two.
+     */
+    template <typename T, std::size_t Alignment = default_alignment>
+    using aligned_buffer = std::vector<T, aligned_allocator<T, Alignment>>;
+
+}} // namespace edsp::types
+
+#endif //EDSP_ALIGNED_ALLOCATOR_HPP
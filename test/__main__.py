@@ -11,6 +11,7 @@ from auditory_test import TestAuditoryMethods
 from temporal_features_test import TestTemporalFeatureMethods
 from statistical_features_test import TestStatisticalFeatureMethods
 from spectral_features_test import TestSpectralFeatureMethods
+from perceptual_features_test import TestPerceptualFeatureMethods
 from filter_test import TestFilterMethods
 from io_test import TestIOMethods
 
@@ -24,7 +25,7 @@ if __name__ == "__main__":
                      TestStatisticsMethods, TestAlgorithmMethods, TestSpectralMethods,
                      TestStringMethods, TestOscillatorMethods, TestAuditoryMethods,
                      TestTemporalFeatureMethods, TestStatisticalFeatureMethods, TestSpectralFeatureMethods,
-                     TestFilterMethods, TestIOMethods)
+                     TestPerceptualFeatureMethods, TestFilterMethods, TestIOMethods)
     ]
     suite = TestSuite(tests)
 
@@ -1,5 +1,6 @@
 import unittest
 import random
+import numpy as np
 import madmom.audio.filters as maf
 import pedsp.auditory as auditory
 import pedsp.algorithm as algorithm
@@ -114,3 +115,43 @@ class TestAuditoryMethods(unittest.TestCase):
             generated = auditory.melspace(min_f, max_f, n)
             for f, bark in zip(frequencies, generated):
                 self.assertAlmostEqual(auditory.hertz2mel(f), bark)
+
+    @staticmethod
+    def __triangular_weights(bands, nfft, sample_rate, f_min, f_max):
+        # HTK Mel scale, the edges of the band k are the points k, k + 1 and k + 2.
+        lower, upper = 2595 * np.log10(1 + np.array([f_min, f_max]) / 700.0)
+        edges = 700 * (10 ** (np.linspace(lower, upper, bands + 2) / 2595) - 1)
+        f = np.arange(nfft // 2 + 1) * sample_rate / float(nfft)
+        weights = np.zeros((bands, nfft // 2 + 1))
+        for k in range(bands):
+            left, center, right = edges[k:k + 3]
+            rising = (f - left) / (center - left)
+            falling = (right - f) / (right - center)
+            weights[k] = np.maximum(0, np.minimum(rising, falling))
+        return weights, edges[1:-1]
+
+    def test_mel_filterbank_weights(self):
+        for bands, nfft, sample_rate, f_min, f_max in [(40, 512, 16000, 0, 8000), (26, 1024, 44100, 300, 8000),
+                                                       (64, 2048, 22050, 20, 11025), (10, 256, 8000, 100, 3800)]:
+            bank = auditory.Filterbank(bands, nfft, sample_rate, f_min, f_max)
+            reference, centers = self.__triangular_weights(bands, nfft, sample_rate, f_min, f_max)
+            self.assertEqual(bank.size(), bands)
+            self.assertEqual(bank.bins(), nfft // 2 + 1)
+            np.testing.assert_allclose(bank.weights(), reference, rtol=1e-9, atol=1e-12)
+            np.testing.assert_allclose(bank.frequencies(), centers, rtol=1e-9)
+
+            normalized = auditory.Filterbank(bands, nfft, sample_rate, f_min, f_max, auditory.AuditoryScale.Mel,
+                                             auditory.FilterbankShape.Triangular, True)
+            sums = reference.sum(axis=1, keepdims=True)
+            expected = np.divide(reference, sums, out=np.zeros_like(reference), where=sums > 0)
+            np.testing.assert_allclose(normalized.weights(), expected, rtol=1e-9, atol=1e-12)
+
+    def test_filterbank_apply(self):
+        for scale in [auditory.AuditoryScale.Mel, auditory.AuditoryScale.Erb, auditory.AuditoryScale.Bark]:
+            for shape in [auditory.FilterbankShape.Triangular, auditory.FilterbankShape.Gammatone]:
+                bank = auditory.Filterbank(32, 1024, 16000, 50, 7000, scale, shape)
+                weights = bank.weights()
+                self.assertEqual(bank.nonzeros(), np.count_nonzero(weights))
+                for _ in range(10):
+                    power = np.random.rand(bank.bins())
+                    np.testing.assert_allclose(bank.apply(power), weights.dot(power), rtol=1e-9)
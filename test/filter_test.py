@@ -2,6 +2,7 @@ import unittest
 import random
 import pedsp.filter as flt
 import numpy as np
+import scipy.signal as signal
 
 class TestFilterMethods(unittest.TestCase):
 
@@ -23,6 +24,65 @@ class TestFilterMethods(unittest.TestCase):
         f.resize(kernel)
         self.assertEqual(f.size(), kernel)
 
+    def test_median_filter(self):
+        for kernel in [1, 2, 7, 16, 33]:
+            data = np.random.randint(-8, 8, size=4 * kernel + 5).astype(np.float64)
+            f = flt.MovingMedianFilter(kernel)
+            generated = f.filter(data)
+            padded = np.concatenate((np.zeros(kernel), data))
+            reference = [np.median(padded[i + 1:i + 1 + kernel]) for i in range(len(data))]
+            np.testing.assert_array_almost_equal(generated, reference)
+
+            f.reset()
+            generated = f.filter(data)
+            reference = [np.median(data[max(0, i + 1 - kernel):i + 1]) for i in range(len(data))]
+            np.testing.assert_array_almost_equal(generated, reference)
+
+    @staticmethod
+    def __integral_quantile(window, q):
+        # Linear interpolation between the two closest order statistics, rounded half away from zero.
+        ordered = sorted(window)
+        position = q * (len(ordered) - 1)
+        index = int(position)
+        fraction = position - index
+        value = float(ordered[index])
+        if fraction > 0 and index + 1 < len(ordered):
+            value = value + fraction * (float(ordered[index + 1]) - value)
+        return int(np.sign(value) * np.floor(abs(value) + 0.5))
+
+    def test_quantile_filter_methods(self):
+        kernel = random.randint(self.__minimum_size, self.__maximum_size)
+        f = flt.MovingQuantileFilter(kernel, 0.25)
+        self.assertEqual(f.size(), kernel)
+        self.assertEqual(f.quantile(), 0.25)
+
+        kernel = random.randint(self.__minimum_size, self.__maximum_size)
+        f.resize(kernel)
+        self.assertEqual(f.size(), kernel)
+        self.assertEqual(f.quantile(), 0.25)
+
+    def test_quantile_filter(self):
+        quantiles = list(np.linspace(0, 1, 11)) + [1 / 3, 2 / 3, 0.125, 0.875]
+        for kernel in range(1, 34):
+            data = np.random.randint(-8, 8, size=3 * kernel + 5)
+            padded = np.concatenate((np.zeros(kernel, dtype=data.dtype), data))
+            for q in quantiles:
+                with self.subTest(kernel=kernel, q=q):
+                    f = flt.MovingQuantileFilter(kernel, q)
+                    g = flt.IntegralMovingQuantileFilter(kernel, q)
+                    windows = [padded[i + 1:i + 1 + kernel] for i in range(len(data))]
+                    np.testing.assert_allclose(f.filter(data.astype(np.float64)),
+                                               [np.quantile(w, q) for w in windows], rtol=1e-12, atol=1e-12)
+                    np.testing.assert_array_equal(g.filter(data), [self.__integral_quantile(w, q) for w in windows])
+
+                    # After a reset, the quantile is computed over the elements received since then.
+                    f.reset()
+                    g.reset()
+                    windows = [data[max(0, i + 1 - kernel):i + 1] for i in range(len(data))]
+                    np.testing.assert_allclose([f(x) for x in data.astype(np.float64)],
+                                               [np.quantile(w, q) for w in windows], rtol=1e-12, atol=1e-12)
+                    np.testing.assert_array_equal(g.filter(data), [self.__integral_quantile(w, q) for w in windows])
+
     def test_average_filter_methods(self):
         kernel = random.randint(self.__minimum_size, self.__maximum_size)
         f = flt.MovingAverageFilter(kernel)
@@ -41,6 +101,185 @@ class TestFilterMethods(unittest.TestCase):
         f.resize(kernel)
         self.assertEqual(f.size(), kernel)
 
+    @staticmethod
+    def __hilbert_taps(N):
+        # Ideal Hilbert transformer truncated to N taps and weighted by the inner samples of a Blackman window.
+        n = np.arange(N) - (N - 1) // 2
+        taps = np.zeros(N)
+        odd = n % 2 == 1
+        taps[odd] = 2 / (np.pi * n[odd]) * np.blackman(N + 2)[1:-1][odd]
+        return taps
+
+    def test_hilbert_filter_methods(self):
+        f = flt.HilbertFilter(31)
+        self.assertEqual(f.size(), 31)
+        self.assertEqual(f.delay(), 15)
+
+    def test_hilbert_filter(self):
+        data = np.random.randn(500)
+        for N in [3, 5, 7, 9, 31, 33, 65]:
+            f = flt.HilbertFilter(N)
+            generated = f.filter(data)
+            delay = (N - 1) // 2
+            np.testing.assert_array_almost_equal(generated.real, np.concatenate((np.zeros(delay), data[:-delay])))
+            np.testing.assert_array_almost_equal(generated.imag, signal.lfilter(self.__hilbert_taps(N), 1, data))
+            self.assertGreater(np.max(np.abs(generated.imag)), 0)
+
+            f.reset()
+            generated = np.array([f(x) for x in data[:50]])
+            np.testing.assert_array_almost_equal(generated.imag, signal.lfilter(self.__hilbert_taps(N), 1, data[:50]))
+
+    def test_hilbert_filter_quadrature(self):
+        # In the passband, the Hilbert transform of a sine is a negated cosine.
+        N = 101
+        delay = (N - 1) // 2
+        t = np.arange(2000)
+        data = np.sin(2 * np.pi * 0.1 * t)
+        generated = flt.HilbertFilter(N).filter(data)
+        reference = -np.cos(2 * np.pi * 0.1 * (t - delay))
+        np.testing.assert_allclose(generated.imag[N:], reference[N:], atol=1e-3)
+
+    @staticmethod
+    def __forward_backward(forward, data, padding):
+        # Reference of the zero-phase filtering: an odd extension of the signal is copied, filtered forward from the
+        # steady state of its first sample, reversed and filtered again.
+        padding = min(padding, data.size - 1)
+        extended = np.concatenate((2 * data[0] - data[padding:0:-1], data,
+                                   2 * data[-1] - data[-2:-padding - 2:-1]))
+        extended = forward(extended)[::-1]
+        extended = forward(extended)[::-1]
+        return extended[padding:padding + data.size]
+
+    def __sos_reference(self, sos, data):
+        zi = signal.sosfilt_zi(sos)
+        forward = lambda x: signal.sosfilt(sos, x, zi=zi * x[0])[0]
+        trivial = min(np.sum(sos[:, 2] == 0), np.sum(sos[:, 5] == 0))
+        return self.__forward_backward(forward, data, 3 * (2 * len(sos) + 1 - trivial))
+
+    def __fir_reference(self, taps, data):
+        zi = signal.lfilter_zi(taps, 1)
+        forward = lambda x: signal.lfilter(taps, 1, x, zi=zi * x[0])[0]
+        return self.__forward_backward(forward, data, 3 * taps.size)
+
+    def test_filtfilt_biquad(self):
+        data = np.random.randn(500)
+        for sos in [signal.butter(2, 0.1, output='sos'), signal.butter(1, 0.3, output='sos'),
+                    signal.cheby1(2, 1, 0.25, btype='high', output='sos')]:
+            generated = flt.filtfilt_sos(data, sos)
+            np.testing.assert_array_almost_equal(generated, self.__sos_reference(sos, data))
+            np.testing.assert_array_almost_equal(generated, signal.sosfiltfilt(sos, data))
+
+    def test_filtfilt_cascade(self):
+        data = np.random.randn(500)
+        for sos in [signal.butter(8, 0.2, output='sos'), signal.cheby1(6, 1, [0.1, 0.3], btype='band', output='sos'),
+                    signal.butter(5, 0.4, output='sos')]:
+            generated = flt.filtfilt_sos(data, sos)
+            np.testing.assert_array_almost_equal(generated, self.__sos_reference(sos, data))
+            np.testing.assert_array_almost_equal(generated, signal.sosfiltfilt(sos, data))
+
+    def test_filtfilt_fir(self):
+        data = np.random.randn(500)
+        for taps in [np.array([0.5, 0.5]), signal.firwin(5, 0.3), signal.firwin(31, 0.2), signal.firwin(64, 0.4)]:
+            generated = flt.filtfilt_fir(data, taps)
+            np.testing.assert_array_almost_equal(generated, self.__fir_reference(taps, data))
+            np.testing.assert_array_almost_equal(generated, signal.filtfilt(taps, 1, data))
+
+    def test_filtfilt_short_signal(self):
+        # The extension is limited to the size of the signal minus one.
+        for size in [1, 2, 5, 20]:
+            data = np.random.randn(size)
+            sos = signal.butter(8, 0.2, output='sos')
+            np.testing.assert_array_almost_equal(flt.filtfilt_sos(data, sos), self.__sos_reference(sos, data))
+            sos = signal.butter(2, 0.1, output='sos')
+            np.testing.assert_array_almost_equal(flt.filtfilt_sos(data, sos), self.__sos_reference(sos, data))
+            taps = signal.firwin(31, 0.2)
+            np.testing.assert_array_almost_equal(flt.filtfilt_fir(data, taps), self.__fir_reference(taps, data))
+
+    def test_parallel_butterworth(self):
+        for order, cutoff in [(2, 1000.0), (6, 5000.0), (12, 12000.0), (16, 200.0), (16, 1000.0), (16, 8000.0)]:
+            cascade = flt.butterworth_lowpass_impulse(order, 48000.0, cutoff, 2000)
+            parallel = flt.butterworth_lowpass_impulse(order, 48000.0, cutoff, 2000, parallel=True)
+            np.testing.assert_allclose(parallel, cascade, atol=1e-11)
+
+        # The partial fractions lose some accuracy at higher orders.
+        cascade = flt.butterworth_lowpass_impulse(24, 48000.0, 8000.0, 2000)
+        parallel = flt.butterworth_lowpass_impulse(24, 48000.0, 8000.0, 2000, parallel=True)
+        np.testing.assert_allclose(parallel, cascade, atol=1e-8)
+
+        # Both realizations are the filter designed by scipy.signal.
+        impulse = np.zeros(2000)
+        impulse[0] = 1
+        reference = signal.sosfilt(signal.butter(16, 1000.0, fs=48000.0, output='sos'), impulse)
+        parallel = flt.butterworth_lowpass_impulse(16, 48000.0, 1000.0, 2000, parallel=True)
+        np.testing.assert_allclose(parallel, reference, atol=1e-9)
+
+    def test_parallel_chebyshev(self):
+        for order in [2, 4, 8]:
+            cascade = flt.chebyshev_bandpass_impulse(order, 48000.0, 6000.0, 2000.0, 1.0, 2000)
+            parallel = flt.chebyshev_bandpass_impulse(order, 48000.0, 6000.0, 2000.0, 1.0, 2000, parallel=True)
+            np.testing.assert_allclose(parallel, cascade, atol=1e-11)
+
+    def test_multichannel_cascade(self):
+        # Every channel matches a biquad_cascade with the same sections, for interleaved, planar and tick processing.
+        data = np.random.randn(997, 4)
+        for sos in [signal.butter(2, 0.1, output='sos'), signal.butter(8, 0.2, output='sos'),
+                    signal.cheby1(8, 1, [0.1, 0.3], btype='band', output='sos')]:
+            reference = np.stack([flt.sosfilt(data[:, i].copy(), sos) for i in range(4)], axis=1)
+            np.testing.assert_allclose(reference, signal.sosfilt(sos, data, axis=0), atol=1e-12)
+            np.testing.assert_allclose(flt.multichannel_sosfilt(data, sos), reference, atol=1e-12)
+            np.testing.assert_allclose(flt.multichannel_sosfilt(data, sos, 'tick'), reference, atol=1e-12)
+            planar = np.ascontiguousarray(data.T)
+            np.testing.assert_allclose(flt.multichannel_sosfilt(planar, sos, 'planar'), reference.T, atol=1e-12)
+
+    def test_multichannel_biquad(self):
+        # Every channel matches a biquad with its own coefficients.
+        data = np.random.randn(997, 4)
+        sos = np.concatenate([signal.butter(2, 0.1, output='sos'), signal.butter(2, 0.3, btype='high', output='sos'),
+                              signal.cheby1(1, 1, [0.2, 0.3], btype='band', output='sos'),
+                              signal.butter(1, 0.2, output='sos')])
+        reference = np.stack([flt.sosfilt(data[:, i].copy(), sos[i:i + 1]) for i in range(4)], axis=1)
+        np.testing.assert_allclose(reference[:, 1], signal.sosfilt(sos[1:2], data[:, 1]), atol=1e-12)
+        np.testing.assert_allclose(flt.multichannel_biquad(data, sos), reference, atol=1e-12)
+        np.testing.assert_allclose(flt.multichannel_biquad(data, sos, 'tick'), reference, atol=1e-12)
+
+        # A single section is replicated in all the channels.
+        reference = np.stack([flt.sosfilt(data[:, i].copy(), sos[:1]) for i in range(4)], axis=1)
+        np.testing.assert_allclose(flt.multichannel_biquad(data, sos[:1]), reference, atol=1e-12)
+
+    @staticmethod
+    def __ramped_reference(data, initial, target, samples):
+        # Transposed Direct Form II whose coefficients move linearly every sample, the last step lands on the target.
+        initial, target = initial[0] / initial[0, 3], target[0] / target[0, 3]
+        output, w0, w1 = np.zeros(data.size), 0.0, 0.0
+        for n, value in enumerate(data):
+            b0, b1, b2, _, a1, a2 = target if n + 1 >= samples else initial + (n + 1) * (target - initial) / samples
+            output[n] = b0 * value + w0
+            w0 = b1 * value - a1 * output[n] + w1
+            w1 = b2 * value - a2 * output[n]
+        return output
+
+    def test_modulated_biquad(self):
+        data = np.random.randn(600)
+        initial = signal.butter(2, 0.05, output='sos')
+        target = signal.butter(2, 0.3, btype='high', output='sos')
+        for samples in [0, 1, 100, 257]:
+            reference = self.__ramped_reference(data, initial, target, samples)
+            for chunk in [1, 7, 64, data.size]:
+                generated, coefficients, ramping = flt.modulated_biquad(data, initial, target, samples, chunk)
+                np.testing.assert_allclose(generated, reference, atol=1e-10)
+                # The ramp lands exactly on the target, whatever the chunks that split it.
+                np.testing.assert_array_equal(coefficients, target[0])
+                self.assertFalse(ramping)
+
+    def test_modulated_biquad_unfinished_ramp(self):
+        data = np.random.randn(50)
+        initial = signal.butter(2, 0.05, output='sos')
+        target = signal.butter(2, 0.3, output='sos')
+        generated, coefficients, ramping = flt.modulated_biquad(data, initial, target, 200, 16)
+        self.assertTrue(ramping)
+        np.testing.assert_allclose(coefficients, initial[0] + 50 * (target[0] - initial[0]) / 200, atol=1e-12)
+        np.testing.assert_allclose(generated, self.__ramped_reference(data, initial, target, 200), atol=1e-10)
+
     # def test_average_filter(self):
     #     for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
     #         kernel = random.randint(0, len(data))
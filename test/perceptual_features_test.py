@@ -0,0 +1,100 @@
+import unittest
+import numpy as np
+import scipy.fftpack
+import pedsp.auditory as auditory
+import pedsp.perceptual as perceptual
+
+
+class TestPerceptualFeatureMethods(unittest.TestCase):
+
+    __sample_rate = 16000
+    __frame_size = 400
+    __hop_size = 160
+    __bands = 40
+    __coefficients = 13
+
+    def __cepstra(self, data, lifter):
+        # Hann window, power spectrum, Mel energies, logarithm and orthonormal DCT-II of every frame.
+        bank = auditory.Filterbank(self.__bands, self.__frame_size, self.__sample_rate, 0, self.__sample_rate / 2)
+        weights = bank.weights()
+        window = np.hanning(self.__frame_size)
+        frames = (len(data) - self.__frame_size) // self.__hop_size + 1
+        cepstra = np.zeros((frames, self.__coefficients))
+        for t in range(frames):
+            frame = data[t * self.__hop_size:t * self.__hop_size + self.__frame_size] * window
+            power = np.abs(np.fft.rfft(frame)) ** 2
+            energies = np.log(np.maximum(weights.dot(power), 1e-10))
+            cepstra[t] = scipy.fftpack.dct(energies, type=2, norm='ortho')[:self.__coefficients]
+        if lifter > 0:
+            n = np.arange(self.__coefficients)
+            cepstra *= 1 + lifter / 2.0 * np.sin(np.pi * n / lifter)
+        return cepstra
+
+    @staticmethod
+    def __regression(frames, width):
+        denominator = 2 * sum(n * n for n in range(1, width + 1))
+        return lambda t: sum(n * (frames(t + n) - frames(t - n)) for n in range(1, width + 1)) / denominator
+
+    def test_mfcc_frames_and_latency(self):
+        samples = 16000
+        for order, width in [(0, 2), (1, 2), (2, 2), (1, 3), (2, 1)]:
+            extractor = perceptual.Mfcc(self.__sample_rate, self.__frame_size, self.__hop_size, self.__bands,
+                                        self.__coefficients, 0, 0, 0, order, width)
+            computed = (samples - self.__frame_size) // self.__hop_size + 1
+            self.assertEqual(extractor.latency(), order * width)
+            self.assertEqual(extractor.features(), self.__coefficients * (order + 1))
+            self.assertEqual(extractor.frames(samples), computed - order * width)
+
+            # Streaming the signal in chunks of any size emits the same frames, latency() frames late, and flushing
+            # the stream emits the remaining ones.
+            data = np.random.uniform(-1, 1, samples)
+            expected = extractor.process(data)
+            self.assertEqual(expected.shape, (computed - order * width, extractor.features()))
+            self.assertEqual(extractor.pending(), order * width)
+            expected = np.concatenate([expected, extractor.flush()])
+            self.assertEqual(expected.shape, (computed, extractor.features()))
+            self.assertEqual(extractor.pending(), 0)
+            self.assertEqual(extractor.flush().shape, (0, extractor.features()))
+
+            extractor.reset()
+            chunks = []
+            for first in range(0, samples, 123):
+                chunk = data[first:first + 123]
+                frames = extractor.frames(len(chunk))
+                generated = extractor.process(chunk)
+                self.assertEqual(generated.shape[0], frames)
+                chunks.append(generated)
+            chunks.append(extractor.flush())
+            np.testing.assert_allclose(np.concatenate(chunks), expected, rtol=1e-9, atol=1e-12)
+
+            # No frame is emitted until latency() frames have been computed after the first one.
+            extractor.reset()
+            length = self.__frame_size + order * width * self.__hop_size
+            self.assertEqual(extractor.process(data[:length - 1]).shape[0], 0)
+            self.assertEqual(extractor.process(data[length - 1:length]).shape[0], 1)
+
+    def test_mfcc(self):
+        data = np.random.uniform(-1, 1, 8000)
+        for lifter in [0, 22]:
+            extractor = perceptual.Mfcc(self.__sample_rate, self.__frame_size, self.__hop_size, self.__bands,
+                                        self.__coefficients, 0, 0, lifter)
+            np.testing.assert_allclose(extractor.process(data), self.__cepstra(data, lifter), rtol=1e-8, atol=1e-10)
+
+    def test_mfcc_deltas(self):
+        data = np.random.uniform(-1, 1, 8000)
+        # Streams longer than the latency, and streams of 1, 2 and 3 frames, shorter than some of the latencies.
+        for frames in [None, 1, 2, 3]:
+            signal = data if frames is None else data[:self.__frame_size + (frames - 1) * self.__hop_size]
+            cepstra = self.__cepstra(signal, 0)
+            for order, width in [(1, 2), (2, 2), (2, 1), (1, 4)]:
+                with self.subTest(frames=frames, order=order, width=width):
+                    extractor = perceptual.Mfcc(self.__sample_rate, self.__frame_size, self.__hop_size, self.__bands,
+                                                self.__coefficients, 0, 0, 0, order, width)
+                    generated = np.concatenate([extractor.process(signal), extractor.flush()])
+                    self.assertEqual(generated.shape[0], cepstra.shape[0])
+                    # The cepstra before the first frame replicate it, and the ones after the last frame replicate it.
+                    deltas = self.__regression(lambda t: cepstra[min(max(t, 0), cepstra.shape[0] - 1)], width)
+                    accelerations = self.__regression(deltas, width)
+                    for t in range(generated.shape[0]):
+                        reference = [cepstra[t], deltas(t)] + ([accelerations(t)] if order == 2 else [])
+                        np.testing.assert_allclose(generated[t], np.concatenate(reference), rtol=1e-8, atol=1e-10)
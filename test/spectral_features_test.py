@@ -70,6 +70,51 @@ class TestSpectralFeatureMethods(unittest.TestCase):
             reference = extractor.stSpectralFlux(data, data)
             self.assertAlmostEqual(generated, reference.item(), 5)
 
+    def test_spectral_flux_different_inputs(self):
+        for size in [1, 2, 17, 1000]:
+            current = np.random.uniform(0.1, 1, size)
+            previous = np.random.uniform(0.1, 10, size)
+            generated = spectral.spectral_flux(current, previous)
+            reference = np.sum((current / current.sum() - previous / previous.sum()) ** 2)
+            self.assertAlmostEqual(generated, reference)
+
+    def test_split_spectral_features(self):
+        # The split-complex overloads compute the features of the magnitude spectrum without materializing it.
+        def spectrum(size):
+            return np.fft.rfft(np.random.uniform(-1, 1, size)) + 0.01
+
+        for size in [2, 17, 1000]:
+            current = spectrum(size)
+            previous = spectrum(size)
+            frequencies = np.linspace(0, 8000, len(current))
+            magnitude = np.abs(current)
+            with self.subTest(size=size):
+                for name in ['crest', 'decrease', 'entropy', 'flatness', 'irregularity', 'kurtosis', 'skewness']:
+                    generated = getattr(spectral, 'split_spectral_' + name)(current)
+                    reference = getattr(spectral, 'spectral_' + name)(magnitude)
+                    np.testing.assert_allclose(generated, reference, rtol=1e-10, atol=1e-12, err_msg=name)
+                for name in ['centroid', 'spread', 'slope']:
+                    generated = getattr(spectral, 'split_spectral_' + name)(current, frequencies)
+                    reference = getattr(spectral, 'spectral_' + name)(magnitude, frequencies)
+                    np.testing.assert_allclose(generated, reference, rtol=1e-10, atol=1e-12, err_msg=name)
+                for name in ['flux', 'variation']:
+                    generated = getattr(spectral, 'split_spectral_' + name)(current, previous)
+                    reference = getattr(spectral, 'spectral_' + name)(magnitude, np.abs(previous))
+                    np.testing.assert_allclose(generated, reference, rtol=1e-10, atol=1e-12, err_msg=name)
+                self.assertEqual(spectral.split_spectral_rolloff(current, 0.85),
+                                 spectral.spectral_rolloff(magnitude, 0.85))
+
+                # The flux of the split spectra matches the numpy reference over the magnitudes.
+                current_normalized = magnitude / magnitude.sum()
+                previous_normalized = np.abs(previous) / np.abs(previous).sum()
+                self.assertAlmostEqual(spectral.split_spectral_flux(current, previous),
+                                       np.sum((current_normalized - previous_normalized) ** 2))
+
+        with self.assertRaises(ValueError):
+            spectral.split_spectral_flux(spectrum(16), spectrum(32))
+        with self.assertRaises(ValueError):
+            spectral.split_spectral_crest(np.ones(16))
+
     def test_spectral_rolloff(self):
         for fs, data in self.__database:
             percentage = random.uniform(0.0, 1.0)
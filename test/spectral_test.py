@@ -1,5 +1,6 @@
 import unittest
 import pedsp.spectral as spectral
+import pedsp.core as core
 import numpy as np
 import scipy.fftpack as fftpack
 import scipy.signal as signal
@@ -11,6 +12,11 @@ class TestSpectralMethods(unittest.TestCase):
     __number_inputs = 10
     __maximum_size = 1 << 14
     __minimum_size = 1 << 6
+    __arbitrary_sizes = [1, 2, 3, 5, 17, 97, 100, 243, 1000, 1009]
+    # Precision of the module: float32 if it is built with ENABLE_SINGLE, as required by the PFFFT backend.
+    __real_type = spectral.rfft(np.zeros(32)).real.dtype
+    __complex_type = np.result_type(__real_type, np.complex64)
+    __tolerance = 1e3 * np.finfo(__real_type).eps
 
     def test_convolution(self):
         first, second = generate_pair_inputs(
@@ -30,12 +36,65 @@ class TestSpectralMethods(unittest.TestCase):
             np.testing.assert_array_almost_equal(
                 generated, reference[len(generated) - 1:])
 
+    def test_convolver(self):
+        # The kernel spectrum is computed once and reused by every call.
+        for size in [1, 7, 64, 100]:
+            kernel = np.random.randn(size).astype(self.__real_type)
+            fixed = spectral.Convolver(kernel)
+            generic = spectral.Convolver(size)
+            self.assertEqual(fixed.size(), size)
+            for _ in range(3):
+                data = np.random.randn(size).astype(self.__real_type)
+                reference = np.convolve(data, kernel)[:size]
+                np.testing.assert_allclose(fixed.process(data), reference, atol=self.__tolerance * size)
+                np.testing.assert_allclose(generic.process(data, kernel), reference, atol=self.__tolerance * size)
+        self.assertRaises(ValueError, fixed.process, np.zeros(size + 1, self.__real_type))
+
+    def test_correlator(self):
+        # The conjugated spectrum of the template is computed once and reused by every call.
+        for size in [1, 7, 64, 100]:
+            pattern = np.random.randn(size).astype(self.__real_type)
+            fixed = spectral.Correlator(pattern)
+            generic = spectral.Correlator(size)
+            biased = spectral.Correlator(pattern, spectral.CorrelationScale.Biased)
+            self.assertEqual(fixed.size(), size)
+            self.assertEqual(biased.scale(), spectral.CorrelationScale.Biased)
+            for _ in range(3):
+                data = np.random.randn(size).astype(self.__real_type)
+                reference = np.correlate(data, pattern, "full")[size - 1:]
+                np.testing.assert_allclose(fixed.process(data), reference, atol=self.__tolerance * size)
+                np.testing.assert_allclose(generic.process(data, pattern), reference, atol=self.__tolerance * size)
+                np.testing.assert_allclose(biased.process(data), reference / (2 * size), atol=self.__tolerance)
+                autocorrelation = np.correlate(data, data, "full")[size - 1:]
+                np.testing.assert_allclose(generic.autocorrelate(data), autocorrelation, atol=self.__tolerance * size)
+            np.testing.assert_allclose(generic.process(pattern, pattern), fixed.autocorrelate(pattern),
+                                       atol=self.__tolerance * size)
+
+    def test_cepstrum_analyzer(self):
+        for size in [2, 7, 64, 100]:
+            analyzer = spectral.CepstrumAnalyzer(size)
+            self.assertEqual(analyzer.size(), size)
+            for _ in range(3):
+                data = np.random.randn(size).astype(self.__real_type)
+                np.testing.assert_allclose(analyzer.process(data), spectral.cepstrum(data), atol=self.__tolerance)
+
     def test_hilbert(self):
         for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
             reference = spectral.hilbert(data)
             generated = signal.hilbert(data)
             np.testing.assert_array_almost_equal(reference, generated)
 
+    def test_hilbert_transformer(self):
+        # The same transformer is reused for every block.
+        data = np.random.randn(3000).astype(self.__real_type)
+        for size in [32, 33, 64, 96, 100, 255]:
+            blocks = data[:data.size // size * size].reshape(-1, size)
+            reference = signal.hilbert(blocks.astype(np.float64), axis=1)
+            generated = spectral.hilbert_blocks(data, size)
+            np.testing.assert_allclose(generated, reference, atol=self.__tolerance)
+            generated = spectral.hilbert_blocks(data, size, quadrature=True)
+            np.testing.assert_allclose(generated, reference.imag, atol=self.__tolerance)
+
     def test_hartley(self):
         for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
             reference = spectral.hartley(data)
@@ -75,9 +134,390 @@ class TestSpectralMethods(unittest.TestCase):
             backward = spectral.ifft(forward)
             np.testing.assert_array_almost_equal(backward, complex_data)
 
+    def test_split_complex_fft(self):
+        for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
+            complex_data = data + 1j * data[::-1]
+            forward = spectral.fft(complex_data)
+            backward = spectral.ifft(forward)
+            for contiguous in [True, False]:
+                generated = spectral.split_fft(complex_data, contiguous)
+                np.testing.assert_array_almost_equal(generated, forward)
+                generated = spectral.split_ifft(forward, contiguous)
+                np.testing.assert_array_almost_equal(generated, backward)
+                np.testing.assert_array_almost_equal(generated, complex_data)
+
+    def test_split_real_fft(self):
+        for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
+            data = data[:len(data) - len(data) % 2]
+            forward = spectral.rfft(data)
+            backward = spectral.irfft(forward)
+            for contiguous in [True, False]:
+                generated = spectral.split_rfft(data, contiguous)
+                np.testing.assert_array_almost_equal(generated, forward)
+                generated = spectral.split_irfft(forward, contiguous)
+                np.testing.assert_array_almost_equal(generated, backward)
+                np.testing.assert_array_almost_equal(generated, data)
+
+    def test_arbitrary_size_fft(self):
+        # Sizes that are not supported natively by every backend, as PFFFT, are computed with Bluestein's algorithm.
+        for size in self.__arbitrary_sizes:
+            data = (np.random.randn(size) + 1j * np.random.randn(size)).astype(self.__complex_type)
+            forward = spectral.fft(data)
+            np.testing.assert_array_almost_equal(forward, np.fft.fft(data))
+            np.testing.assert_array_almost_equal(spectral.ifft(forward), data)
+
+    def test_arbitrary_size_real_fft(self):
+        for size in self.__arbitrary_sizes:
+            data = np.random.randn(size - size % 2 + 2).astype(self.__real_type)
+            forward = spectral.rfft(data)
+            np.testing.assert_array_almost_equal(forward, np.fft.rfft(data))
+            np.testing.assert_array_almost_equal(spectral.irfft(forward), data)
+
+    def test_arbitrary_size_dct(self):
+        for size in self.__arbitrary_sizes:
+            data = np.random.randn(size).astype(self.__real_type)
+            forward = spectral.dct(data)
+            np.testing.assert_array_almost_equal(forward, fftpack.dct(data))
+            np.testing.assert_array_almost_equal(spectral.idct(forward), data)
+
+    def test_batched_fft(self):
+        for size in [16, 17, 100, 1000]:
+            data = np.random.randn(5, size) + 1j * np.random.randn(5, size)
+            forward = spectral.fft_many(data)
+            np.testing.assert_array_almost_equal(forward, np.fft.fft(data, axis=1))
+            np.testing.assert_array_almost_equal(spectral.ifft_many(forward), data)
+
+    def test_batched_real_fft(self):
+        for size in [16, 18, 100, 1000]:
+            data = np.random.randn(5, size)
+            forward = spectral.rfft_many(data)
+            np.testing.assert_array_almost_equal(forward, np.fft.rfft(data, axis=1))
+            np.testing.assert_array_almost_equal(spectral.irfft_many(forward), data)
+
+    def test_czt(self):
+        for size in self.__arbitrary_sizes:
+            data = np.random.randn(size) + 1j * np.random.randn(size)
+            generated = spectral.czt(data, size, np.exp(-2j * np.pi / size))
+            np.testing.assert_array_almost_equal(generated, np.fft.fft(data))
+
+            # Zoom over a narrow arc of the unit circle, compared with the definition of the transform.
+            w, a, points = np.exp(-0.01j), np.exp(0.3j), 7
+            z = a * w ** -np.arange(points)
+            reference = np.array([np.sum(data * zk ** -np.arange(size)) for zk in z])
+            np.testing.assert_array_almost_equal(spectral.czt(data, points, w, a), reference)
+
+    @staticmethod
+    def __constant_q_length(sample_rate, frequency, bins_per_octave, gamma):
+        return int(np.ceil(sample_rate / ((2 ** (1 / bins_per_octave) - 1) * frequency + gamma)))
+
+    def __constant_q_reference(self, frame, sample_rate, f_min, bins_per_octave, bins, gamma):
+        # Direct evaluation of the Hamming-windowed temporal kernels, all of them centered in the frame.
+        reference = []
+        for k in bins:
+            frequency = f_min * 2 ** (k / bins_per_octave)
+            size = min(frame.size, self.__constant_q_length(sample_rate, frequency, bins_per_octave, gamma))
+            start = (frame.size - size) // 2
+            kernel = np.hamming(size) / size * np.exp(2j * np.pi * frequency / sample_rate * np.arange(size))
+            reference.append(np.sum(frame[start:start + size] * np.conj(kernel)))
+        return np.array(reference)
+
+    def test_constant_q(self):
+        sample_rate = 8000.0
+        for f_min, f_max, bins_per_octave, gamma in [(100.0, 3000.0, 12, 0.0), (55.0, 4000.0, 24, 0.0),
+                                                     (100.0, 3500.0, 12, 20.0)]:
+            fft_size = 1 << (self.__constant_q_length(sample_rate, f_min, bins_per_octave, gamma) - 1).bit_length()
+            t = np.arange(fft_size) / sample_rate
+            frame = (np.sin(2 * np.pi * 440 * t) + 0.5 * np.random.randn(fft_size)).astype(self.__real_type)
+            generated = spectral.cqt(frame, sample_rate, f_min, f_max, bins_per_octave, threshold=0, gamma=gamma)
+            self.assertEqual(generated.size, int(np.floor(bins_per_octave * np.log2(f_max / f_min))) + 1)
+            tone = int(round(bins_per_octave * np.log2(440 / f_min)))
+            bins = [0, 1, bins_per_octave, tone, generated.size // 2, generated.size - 1]
+            reference = self.__constant_q_reference(frame, sample_rate, f_min, bins_per_octave, bins, gamma)
+            np.testing.assert_allclose(generated[bins], reference, atol=self.__tolerance)
+
+            # The sparse kernel discards the spectral values below the threshold, a small error next to the tone.
+            generated = spectral.cqt(frame, sample_rate, f_min, f_max, bins_per_octave, gamma=gamma)
+            np.testing.assert_allclose(generated[bins], reference, atol=5e-2 * np.max(np.abs(reference)))
+
+            # Shorter frames are zero padded.
+            generated = spectral.cqt(frame[:fft_size // 2], sample_rate, f_min, f_max, bins_per_octave, threshold=0,
+                                     gamma=gamma)
+            padded = np.concatenate((frame[:fft_size // 2], np.zeros(fft_size - fft_size // 2)))
+            reference = self.__constant_q_reference(padded, sample_rate, f_min, bins_per_octave, bins, gamma)
+            np.testing.assert_allclose(generated[bins], reference, atol=self.__tolerance)
+
+    def test_goertzel(self):
+        sample_rate = 8000.0
+        for size in self.__arbitrary_sizes:
+            data = np.random.randn(size)
+            bins = np.arange(0, size, max(1, size // 5))
+            frequencies = bins * sample_rate / size
+            generated = spectral.goertzel(data, frequencies, sample_rate)
+            np.testing.assert_array_almost_equal(generated, np.fft.fft(data)[bins])
+
+    def test_sliding_dft(self):
+        for size in self.__arbitrary_sizes:
+            data = np.random.randn(3 * size + 5)
+            bins = np.arange(0, size, max(1, size // 4), dtype=np.int64)
+            generated = spectral.sliding_dft(data, bins, size)
+            np.testing.assert_array_almost_equal(generated, np.fft.fft(data[-size:])[bins])
+
+    def test_partitioned_convolution(self):
+        for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
+            for taps, block_size in [(1, 16), (5, 16), (64, 64), (300, 16), (300, 64)]:
+                kernel = np.random.randn(taps)
+                generated = spectral.partitioned_conv(data, kernel, block_size)
+                np.testing.assert_array_almost_equal(generated, np.convolve(data, kernel))
+
+    def test_partitioned_convolution_blocks(self):
+        # Blocks whose spectra have an odd number of bins and kernels spanning several partitions, with the stream
+        # pushed in chunks that do not match the blocks.
+        data = np.random.randn(3000).astype(self.__real_type)
+        for taps in [17, 100, 1000]:
+            kernel = np.random.randn(taps).astype(self.__real_type)
+            reference = np.convolve(data.astype(np.float64), kernel.astype(np.float64))
+            for block_size in [8, 16, 24, 48, 64]:
+                generated = spectral.partitioned_conv(data, kernel, block_size)
+                np.testing.assert_allclose(generated, reference, atol=self.__tolerance * np.max(np.abs(reference)))
+
+    def test_block_convolution(self):
+        # Chunks smaller than, equal to and larger than the block size, and kernels longer than the blocks.
+        data = np.random.randn(1000).astype(self.__real_type)
+        for method in [spectral.ConvolutionMethod.OverlapSave, spectral.ConvolutionMethod.OverlapAdd]:
+            for kernel_size, block_size in [(1, 16), (31, 64), (64, 64), (200, 32), (513, 100)]:
+                kernel = np.random.randn(kernel_size).astype(self.__real_type)
+                reference = np.convolve(data, kernel)
+                stream = np.concatenate([data, np.zeros(kernel_size - 1, self.__real_type)])
+                convolver = spectral.BlockConvolver(kernel, block_size, method)
+                self.assertEqual(convolver.method(), method)
+                self.assertEqual(convolver.kernel_size(), kernel_size)
+                for chunk in [block_size, 7, 3 * block_size + 5]:
+                    convolver.reset()
+                    chunks = [stream[i:i + chunk] for i in range(0, len(stream), chunk)]
+                    generated = np.concatenate([convolver.process(c) for c in chunks])
+                    np.testing.assert_allclose(generated, reference, atol=self.__tolerance * kernel_size)
+
+    def test_block_convolution_reset(self):
+        data = np.random.randn(300).astype(self.__real_type)
+        kernel = np.random.randn(50).astype(self.__real_type)
+        for method in [spectral.ConvolutionMethod.OverlapSave, spectral.ConvolutionMethod.OverlapAdd]:
+            convolver = spectral.BlockConvolver(kernel, 40, method)
+            first = convolver.process(data)
+            np.testing.assert_allclose(first, np.convolve(data, kernel)[:len(data)], atol=self.__tolerance * 50)
+            self.assertFalse(np.allclose(convolver.process(data), first))
+            convolver.reset()
+            np.testing.assert_allclose(convolver.process(data), first, atol=self.__tolerance)
+
+    def test_stft(self):
+        data = np.random.randn(1000).astype(self.__real_type)
+        for frame_size, hop_size in [(64, 16), (96, 32), (256, 64)]:
+            window = np.hanning(frame_size)
+            frames = (data.size - frame_size) // hop_size + 1
+            reference = np.array([np.fft.rfft(window * data[i * hop_size:i * hop_size + frame_size])
+                                  for i in range(frames)])
+            generated = spectral.stft(data, frame_size, hop_size)
+            self.assertEqual(generated.shape, reference.shape)
+            np.testing.assert_allclose(generated, reference, atol=self.__tolerance * np.max(np.abs(reference)))
+
+    def test_stft_reconstruction(self):
+        # The first frame_size - hop_size samples are not overlapped by all the frames yet.
+        data = np.random.randn(1000).astype(self.__real_type)
+        for frame_size, hop_size in [(64, 16), (64, 24), (96, 32), (256, 64), (256, 128)]:
+            frames = spectral.stft(data, frame_size, hop_size)
+            generated = spectral.istft(frames, frame_size, hop_size)
+            self.assertEqual(generated.size, frames.shape[0] * hop_size)
+            settled = frame_size - hop_size
+            np.testing.assert_allclose(generated[settled:], data[settled:generated.size], atol=self.__tolerance)
+
+    def test_welch(self):
+        # Segments detrended with their mean and weighted by a symmetric Hann window, with the density scaling.
+        data = np.random.randn(3000).astype(self.__real_type)
+        sample_rate = 8000.0
+        for segment_size, overlap in [(64, 0), (64, 32), (96, 17), (256, 192)]:
+            window = np.hanning(segment_size)
+            hop_size = segment_size - overlap
+            segments = (data.size - segment_size) // hop_size + 1
+            reference = np.zeros(segment_size // 2 + 1)
+            for i in range(segments):
+                segment = data[i * hop_size:i * hop_size + segment_size].astype(np.float64)
+                reference += np.abs(np.fft.rfft((segment - np.mean(segment)) * window)) ** 2
+            reference /= segments * sample_rate * np.sum(window ** 2)
+            reference[1:-1] *= 2
+            generated = spectral.welch(data, segment_size, overlap, sample_rate)
+            np.testing.assert_allclose(generated, reference, atol=self.__tolerance * np.max(reference))
+
+    def test_welch_options(self):
+        # Odd segment sizes have no Nyquist bin, so all the bins but the DC one are folded in the one-sided estimate.
+        data = np.random.randn(2000).astype(self.__real_type)
+        sample_rate = 8000.0
+        detrends = [(spectral.DetrendType.NoDetrend, False), (spectral.DetrendType.Constant, 'constant'),
+                    (spectral.DetrendType.Linear, 'linear')]
+        scalings = [(spectral.PsdScaling.Density, 'density'), (spectral.PsdScaling.Spectrum, 'spectrum')]
+        sides = [(spectral.PsdSides.OneSided, True), (spectral.PsdSides.TwoSided, False)]
+        for segment_size, overlap in [(64, 32), (63, 20), (97, 0), (33, 32)]:
+            for detrend, scipy_detrend in detrends:
+                for scaling, scipy_scaling in scalings:
+                    for side, onesided in sides:
+                        with self.subTest(segment_size=segment_size, overlap=overlap, detrend=detrend,
+                                          scaling=scaling, side=side):
+                            frequencies, reference = signal.welch(
+                                data.astype(np.float64), sample_rate, window=np.hanning(segment_size),
+                                nperseg=segment_size, noverlap=overlap, detrend=scipy_detrend,
+                                return_onesided=onesided, scaling=scipy_scaling)
+                            estimator = spectral.Welch(segment_size, overlap, sample_rate, detrend, scaling, side)
+                            estimator.process(data)
+                            self.assertEqual(estimator.bins(), reference.size)
+                            np.testing.assert_allclose(estimator.estimate(), reference,
+                                                       atol=self.__tolerance * np.max(reference))
+                            np.testing.assert_allclose(estimator.frequencies(), frequencies,
+                                                       atol=self.__tolerance * sample_rate)
+                            generated = spectral.welch(data, segment_size, overlap, sample_rate, detrend, scaling,
+                                                       side)
+                            np.testing.assert_allclose(generated, reference, atol=self.__tolerance * np.max(reference))
+
     def test_periodogram(self):
         for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
             data = 10 * data
             generated = spectral.spectrum(data)
             reference = np.abs(np.fft.rfft(data)) ** 2
             np.testing.assert_array_almost_equal(generated, reference, 3)
+
+    def test_plan_cache_sharing(self):
+        # Two engines of the same size and layout share a single plan.
+        spectral.clear_plan_cache()
+        spectral.reset_plan_cache_statistics()
+        data = (np.random.randn(384) + 1j * np.random.randn(384)).astype(self.__complex_type)
+        first = spectral.FFTEngine(384).fft(data)
+        self.assertEqual((spectral.plan_cache_misses(), spectral.plan_cache_hits()), (1, 0))
+        second = spectral.FFTEngine(384).fft(data)
+        self.assertEqual((spectral.plan_cache_misses(), spectral.plan_cache_hits()), (1, 1))
+        self.assertEqual(spectral.plan_cache_size(), 1)
+        np.testing.assert_array_equal(first, second)
+
+    def test_plan_cache_eviction(self):
+        def request(size):
+            spectral.FFTEngine(size).rfft(np.zeros(size, self.__real_type))
+
+        capacity = spectral.plan_cache_capacity()
+        try:
+            spectral.clear_plan_cache()
+            spectral.set_plan_cache_capacity(2)
+            spectral.reset_plan_cache_statistics()
+            request(64)
+            request(96)
+            request(64)
+            # The plan of 96 samples is the least recently used one.
+            request(128)
+            self.assertEqual(spectral.plan_cache_size(), 2)
+            self.assertEqual((spectral.plan_cache_misses(), spectral.plan_cache_hits()), (3, 1))
+            request(64)
+            request(96)
+            self.assertEqual((spectral.plan_cache_misses(), spectral.plan_cache_hits()), (4, 2))
+
+            # Shrinking the cache keeps the most recently used plan, 96, and evicts 64.
+            spectral.set_plan_cache_capacity(1)
+            self.assertEqual(spectral.plan_cache_size(), 1)
+            request(96)
+            request(64)
+            self.assertEqual((spectral.plan_cache_misses(), spectral.plan_cache_hits()), (5, 3))
+        finally:
+            spectral.set_plan_cache_capacity(capacity)
+
+    def test_aligned_allocator(self):
+        alignment = spectral.default_alignment()
+        self.assertEqual(alignment & (alignment - 1), 0)
+        # The alignment expected by the backend is satisfied by any buffer allocated with the default alignment.
+        self.assertEqual(alignment % spectral.fft_alignment(), 0)
+        for size in [0, 1, 3, 17, 64, 1000, 1 << 16]:
+            with self.subTest(size=size):
+                self.assertEqual(spectral.aligned_allocation_offsets(size), [0, 0, 0, 0])
+                if size > 1:
+                    real, complex, shifted = spectral.aligned_buffer_is_aligned(size)
+                    self.assertTrue(real)
+                    self.assertTrue(complex)
+                    self.assertEqual(shifted, spectral.fft_alignment() <= np.dtype(self.__real_type).itemsize)
+
+    def test_threads(self):
+        size = 1 << 16
+        data = (np.random.randn(size) + 1j * np.random.randn(size)).astype(self.__complex_type)
+        single = spectral.FFTEngine(size)
+        threaded = spectral.FFTEngine(size, spectral.PlanningRigor.Estimate, 4)
+        self.assertEqual(single.threads(), 1)
+        if not spectral.fft_threads_supported():
+            # Without the threaded FFTW libraries every engine is single-threaded and shares the same plans.
+            self.assertEqual(threaded.threads(), 1)
+            spectral.clear_plan_cache()
+            spectral.reset_plan_cache_statistics()
+            single.fft(data)
+            threaded.fft(data)
+            self.assertEqual((spectral.plan_cache_misses(), spectral.plan_cache_hits()), (1, 1))
+            self.assertEqual(spectral.plan_cache_size(), 1)
+            return
+
+        self.assertEqual(threaded.threads(), 4)
+        spectral.clear_plan_cache()
+        spectral.reset_plan_cache_statistics()
+        for transform in ['fft', 'ifft']:
+            reference = getattr(single, transform)(data)
+            generated = getattr(threaded, transform)(data)
+            np.testing.assert_allclose(generated, reference, rtol=self.__tolerance, atol=self.__tolerance)
+        for transform in ['rfft', 'dct', 'idct']:
+            reference = getattr(single, transform)(data.real.copy())
+            generated = getattr(threaded, transform)(data.real.copy())
+            np.testing.assert_allclose(generated, reference, rtol=self.__tolerance, atol=self.__tolerance)
+
+        # The single-threaded and the threaded plans are stored under distinct keys and coexist in the cache.
+        self.assertEqual((spectral.plan_cache_misses(), spectral.plan_cache_hits()), (10, 0))
+        self.assertEqual(spectral.plan_cache_size(), 10)
+        spectral.FFTEngine(size).fft(data)
+        spectral.FFTEngine(size, spectral.PlanningRigor.Estimate, 4).fft(data)
+        self.assertEqual((spectral.plan_cache_misses(), spectral.plan_cache_hits()), (10, 2))
+        self.assertEqual(spectral.plan_cache_size(), 10)
+
+    def test_planning_rigor(self):
+        # More rigorous plans compute the same transforms, they are only expected to be faster.
+        size = 32
+        data = (np.random.randn(size) + 1j * np.random.randn(size)).astype(self.__complex_type)
+        reference = spectral.FFTEngine(size)
+        for rigor in [spectral.PlanningRigor.Measure, spectral.PlanningRigor.Patient,
+                      spectral.PlanningRigor.Exhaustive]:
+            engine = spectral.FFTEngine(size, rigor)
+            self.assertEqual(engine.rigor(), rigor)
+            np.testing.assert_allclose(engine.fft(data), reference.fft(data), atol=self.__tolerance)
+            np.testing.assert_allclose(engine.rfft(data.real), reference.rfft(data.real), atol=self.__tolerance)
+            np.testing.assert_allclose(engine.dct(data.real), reference.dct(data.real), atol=self.__tolerance)
+
+    def test_wisdom_round_trip(self):
+        if core.get_fft_library() != "fftw":
+            self.skipTest("Only the FFTW backend accumulates wisdom")
+        spectral.FFTEngine(1536, spectral.PlanningRigor.Measure).rfft(np.zeros(1536, self.__real_type))
+        wisdom = spectral.export_wisdom()
+        self.assertNotEqual(wisdom, "")
+
+        spectral.forget_wisdom()
+        self.assertNotEqual(spectral.export_wisdom(), wisdom)
+        self.assertTrue(spectral.import_wisdom(wisdom))
+        # The entries are exported in the order of the internal hash table of the planner.
+        self.assertEqual(sorted(spectral.export_wisdom().splitlines()), sorted(wisdom.splitlines()))
+        self.assertFalse(spectral.import_wisdom("not a wisdom string"))
+
+    def test_interleaved_transforms(self):
+        # Every transform kind keeps its own plan per alignment, switching between them must not
+        # reuse the plan of another kind or execute an aligned plan on misaligned data.
+        size = 256
+        engine = spectral.FFTEngine(size)
+        data = (np.random.randn(size) + 1j * np.random.randn(size)).astype(self.__complex_type)
+        real = data.real.copy()
+        for aligned in [True, False, False, True, False]:
+            forward = engine.fft(data, aligned)
+            np.testing.assert_allclose(forward, np.fft.fft(data), atol=self.__tolerance * size)
+            np.testing.assert_allclose(engine.ifft(forward, aligned), data, atol=self.__tolerance)
+            np.testing.assert_allclose(engine.fft(data, not aligned), forward, atol=self.__tolerance)
+
+            transformed = engine.dct(real, aligned)
+            np.testing.assert_allclose(transformed, fftpack.dct(real), atol=self.__tolerance * size)
+            np.testing.assert_allclose(engine.idct(transformed, aligned), real, atol=self.__tolerance)
+
+            spectrum = engine.rfft(real, aligned)
+            np.testing.assert_allclose(spectrum, np.fft.rfft(real), atol=self.__tolerance * size)
+            np.testing.assert_allclose(engine.irfft(spectrum, not aligned), real, atol=self.__tolerance)
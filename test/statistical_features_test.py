@@ -70,6 +70,14 @@ class TestStatisticalFeatureMethods(unittest.TestCase):
             reference = extractor.stSpectralFlux(data, data)
             self.assertAlmostEqual(generated, reference)
 
+    def test_flux_different_inputs(self):
+        for size in [1, 2, 17, 1000]:
+            current = np.random.uniform(0.1, 1, size)
+            previous = np.random.uniform(0.1, 10, size)
+            generated = statistics.flux(current, previous)
+            reference = np.sum((current / current.sum() - previous / previous.sum()) ** 2)
+            self.assertAlmostEqual(generated, reference)
+
     def test_rolloff(self):
         for fs, data in self.__database:
             percentage = random.uniform(0.0, 1.0)
@@ -13,7 +13,6 @@ class TestStatisticsMethods(unittest.TestCase):
     __maximum_size = 1 << 14
     __minimum_size = 1 << 6
 
-    # TODO: test median
     # TODO: implement this list https://www.programcreek.com/python/example/66766/scipy.stats.kurtosis
 
     def test_max(self):
@@ -46,6 +45,13 @@ class TestStatisticsMethods(unittest.TestCase):
             reference = np.argmax(np.abs(data))
             self.assertAlmostEqual(generated, reference)
 
+    def test_median(self):
+        for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
+            for size in [1, 2, len(data) - (len(data) % 2), len(data) - (len(data) % 2) + 1]:
+                generated = statistics.median(data[:size])
+                reference = np.median(data[:size])
+                self.assertAlmostEqual(generated, reference.item())
+
     def test_norm(self):
         for data in generate_inputs(self.__number_inputs, self.__minimum_size, self.__maximum_size):
             generated = statistics.norm(data)